@@ -1,21 +1,7 @@
 #ifndef JEP_SWAP_NATIVE_H
 #define JEP_SWAP_NATIVE_H
 
-#include "swap/object.h"
-#include "swap/native.h"
-#include "swap/stringbuilder.h"
-
-#if defined(_WIN32)
-#	if defined(SWAPNATIVE_EXPORTS) || defined(__CYGWIN__)
-#		define SWAPNATIVE_API __declspec(dllexport)
-#	else
-#		define SWAPNATIVE_API __declspec(dllimport)
-#	endif
-#	define SWAPNATIVE_CALL __cdecl
-#elif defined(__linux__) || defined(__unix__) || defined(__MACH__)
-#	define SWAPNATIVE_API
-#	define SWAPNATIVE_CALL
-#endif
+#include "swap/extension.h"
 
 
 
@@ -25,6 +11,7 @@
  * For primitive types such as integers and characters, the length is 1.
  * For strings, the length is the number of characters in the string.
  * For arrays, the length is the number of objects in the array.
+ * For buffers, the length is the number of bytes in the buffer.
  * For all other objects, the length is returned as a null object.
  */
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_len(jep_obj *args, jep_obj* list);
@@ -94,6 +81,38 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_byte(jep_obj *args, jep_obj* list);
 */
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_bytes(jep_obj *args, jep_obj* list);
 
+/**
+* Creates a buffer of bytes
+*
+* The bytes of a buffer are stored in a single block of memory.
+* They can be accessed by index like the elements of an array.
+* Example:
+*     b = buffer(512); // b now holds 512 bytes with the value 0
+*
+*/
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_buffer(jep_obj *args, jep_obj* list);
+
+/**
+* Converts an object into a string
+*
+* The bytes of a buffer are converted into the characters of the string.
+* All other objects are converted into their string representation.
+* Example:
+*     s = str(bytes("abc")); // s now has the string value "abc"
+*
+*/
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_str(jep_obj *args, jep_obj* list);
+
+/**
+* Copies a range of bytes from a buffer into a new buffer
+*
+* The range starts at the first index and ends before the second.
+* Example:
+*     b = slice(bytes("abcd"), 1, 3); // b now holds the bytes of "bc"
+*
+*/
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_slice(jep_obj *args, jep_obj* list);
+
 /**
  * Writes a string of bytes to standard output
  */
@@ -195,7 +214,7 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_startThread(jep_obj* args, jep_obj*
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_sleep(jep_obj* args, jep_obj* list);
 
 /**
- * prints the amount of object creation and destruciton in the native library
+ * prints the allocation statistics of the native library
  */
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_print_native_call_count();
 
@@ -19,12 +19,37 @@
 #define JEP_AST_H
 
 #include "swap/tokenizer.h"
+#include "swap/table.h"
 
 /* for loop components */
 #define JEP_INDEX 1
 #define JEP_CONDITION 2
 #define JEP_CHANGE 4
 
+/* loop flags */
+#define JEP_UNSCOPED 8 /* an iteration or switch never adds objects to its scope */
+#define JEP_COUNTED 16 /* a for loop of the form for (i = a; i < n; i++) */
+
+/* return flags */
+#define JEP_TAIL 32 /* returns a call to the function it is in */
+
+/* assignment flags */
+#define JEP_DISCARDED 64 /* the value of an assignment to this is never used */
+
+/* compiled bytecode (defined in compiler.h) */
+struct Chunk;
+
+/* the blocks of a switch statement whose case labels are all literals */
+typedef struct CaseTable
+{
+	int type;                 /* type of every label                     */
+	int min;                  /* smallest label of an int, char or byte  */
+	int size;                 /* number of entries in blocks             */
+	struct ASTNode** blocks;  /* block of each label from min, or NULL   */
+	jep_table* strings;       /* block of each string label              */
+	struct ASTNode* fallback; /* block of the default label              */
+}jep_case_table;
+
 /* a node in an AST */
 typedef struct ASTNode
 {
@@ -36,6 +61,15 @@ typedef struct ASTNode
 	int array;              /* whether or not something is an array */
 	int loop;               /* keeps track of loop expressions      */
 	int mod;                /* modifiers                            */
+	struct Chunk* code;     /* compiled bytecode of a function body */
+	int slot;               /* frame slot of a resolved identifier  */
+	int slots;              /* number of frame slots of a function  */
+	int target;             /* whether something is assigned to     */
+	struct Object* value;   /* value of a literal in the const pool */
+	struct ASTNode* shape;  /* struct shape last seen by a member access */
+	int member;             /* slot of the member in that shape     */
+	int quick;              /* operation a node has specialized to  */
+	jep_case_table* cases;  /* jump table of a switch statement     */
 }jep_ast_node;
 
 /* a stack of nodes */
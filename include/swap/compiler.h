@@ -0,0 +1,121 @@
+/*
+	Functions for compiling an abstract syntax tree into bytecode
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_COMPILER_H
+#define JEP_COMPILER_H
+
+#include "swap/operator.h"
+
+/* operation codes */
+#define OP_END 0          /* returns the top of the stack              */
+#define OP_NONE 1         /* pushes the absence of a value             */
+#define OP_NULL 2         /* pushes a null object                      */
+#define OP_NUMBER 3       /* pushes a number literal                   */
+#define OP_CHARACTER 4    /* pushes a character literal                */
+#define OP_STRING 5       /* pushes a string literal                   */
+#define OP_LOAD 6         /* pushes the value of an identifier         */
+#define OP_DROP 7         /* destroys the top of the stack             */
+#define OP_ADD 8          /* + */
+#define OP_SUB 9          /* - */
+#define OP_MUL 10         /* * */
+#define OP_DIV 11         /* / */
+#define OP_MOD 12         /* % */
+#define OP_LESS 13        /* < */
+#define OP_GREATER 14     /* > */
+#define OP_LOREQUAL 15    /* <= */
+#define OP_GOREQUAL 16    /* >= */
+#define OP_EQUIV 17       /* == */
+#define OP_NOTEQ 18       /* != */
+#define OP_BITAND 19      /* & */
+#define OP_BITOR 20       /* | */
+#define OP_BITXOR 21      /* ^ */
+#define OP_LSHIFT 22      /* << */
+#define OP_RSHIFT 23      /* >> */
+#define OP_NEG 24         /* unary - */
+#define OP_NOT 25         /* ! */
+#define OP_AND_LEFT 26    /* jumps if the left operand decides && */
+#define OP_AND 27         /* && */
+#define OP_OR_LEFT 28     /* jumps if the left operand decides || */
+#define OP_OR 29          /* || */
+#define OP_ASSIGN 30      /* = */
+#define OP_INC 31         /* ++ */
+#define OP_DEC 32         /* -- */
+#define OP_FUNC 33        /* pushes the function to be called          */
+#define OP_CALL 34        /* calls a function                          */
+#define OP_ARRAY 35       /* creates an array of a certain size        */
+#define OP_SUBSCRIPT 36   /* accesses an element of an array           */
+#define OP_RETURN 37      /* marks the top of the stack as returned    */
+#define OP_THROW 38       /* marks the top of the stack as thrown      */
+#define OP_EVAL 39        /* evaluates an AST node with the tree walker */
+#define OP_JUMP 40        /* jumps to an instruction                   */
+#define OP_BRANCH 41      /* evaluates the condition of an if          */
+#define OP_LOOP 42        /* evaluates the first condition of a loop   */
+#define OP_NEXT 43        /* ends an iteration of a loop               */
+#define OP_PUSH_SCOPE 44  /* adds a scope                              */
+#define OP_POP_SCOPE 45   /* removes a scope                           */
+#define OP_POP_BLOCK 46   /* ends a statement in a block               */
+#define OP_POP_LOOP 47    /* ends the body of a loop                   */
+#define OP_POP_TOP 48     /* ends a statement at the top level         */
+#define OP_CATCH 49       /* catches an exception                      */
+#define OP_CLEAR 50       /* discards a value that was not returned    */
+#define OP_ADD_ASSIGN 51  /* += */
+#define OP_COUNT_NEXT 52  /* ends an iteration of a counted loop       */
+#define OP_TAIL_CALL 53   /* calls a function from a return statement  */
+#define OP_QUICK 54       /* applies an operator to variables or literals */
+#define OP_STORE 55       /* assigns the top of the stack to a variable */
+#define OP_MEMBER 56      /* accesses a member of a struct             */
+#define OP_SWITCH 57      /* jumps to the block of a switch statement  */
+
+#define OP_COUNT 58
+
+/* a single bytecode instruction */
+typedef struct Instruction
+{
+	int op;             /* operation code                    */
+	int a;              /* first operand                     */
+	int b;              /* second operand                    */
+	jep_ast_node *node; /* the AST node that was compiled    */
+}jep_instr;
+
+/* a compiled sequence of instructions */
+typedef struct Chunk
+{
+	const char *name;   /* name of the function or main      */
+	jep_instr *code;    /* instructions                      */
+	int size;           /* number of instructions            */
+	int cap;            /* capacity                          */
+	int stack;          /* maximum depth of the operand stack */
+	int scopes;         /* maximum number of nested scopes   */
+	struct Chunk *next; /* next chunk of the same program    */
+}jep_chunk;
+
+/**
+ * compiles an AST into bytecode
+ */
+jep_chunk* jep_compile(jep_ast_node* root);
+
+/**
+ * prints the instructions of compiled bytecode
+ */
+void jep_print_chunk(jep_chunk* chunk);
+
+/**
+ * frees the memory used by compiled bytecode
+ */
+void jep_destroy_chunk(jep_chunk* chunk);
+
+#endif
@@ -0,0 +1,75 @@
+/*
+	The interface between the Swap runtime and native extensions
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_EXTENSION_H
+#define JEP_EXTENSION_H
+
+#include "swap/object.h"
+#include "swap/native.h"
+#include "swap/stringbuilder.h"
+#include "swap/pool.h"
+
+/**
+ * the version of the extension interface.
+ * it changes whenever a function that extensions rely on
+ * changes in a way that requires them to be rebuilt.
+ */
+#define SWAP_API_VERSION 1
+
+#if defined(_WIN32)
+#	if defined(SWAPNATIVE_EXPORTS) || defined(__CYGWIN__)
+#		define SWAPNATIVE_API __declspec(dllexport)
+#	else
+#		define SWAPNATIVE_API __declspec(dllimport)
+#	endif
+#	define SWAPNATIVE_CALL __cdecl
+#elif defined(__linux__) || defined(__unix__) || defined(__MACH__)
+#	define SWAPNATIVE_API
+#	define SWAPNATIVE_CALL
+#endif
+
+/**
+ * defines a native function.
+ * a Swap program calls it after declaring it without a body:
+ *     function name(a, b);
+ * the arguments are the objects of args, and list is the main list.
+ */
+#define SWAP_NATIVE(name) \
+	SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_##name(jep_obj* args, jep_obj* list)
+
+/**
+ * gets the version of the extension interface implemented by the runtime.
+ * an extension built against a different SWAP_API_VERSION should not
+ * be used.
+ *
+ * extensions are linked against the same runtime as the interpreter,
+ * so the objects they create come from the same pool. they may rely on
+ * the following functions:
+ *
+ *   objects:  jep_create_object, jep_destroy_object, jep_copy_object,
+ *             jep_to_string, jep_compare_object
+ *   scalars:  jep_set_int, jep_set_long, jep_set_double, jep_set_byte,
+ *             jep_set_char
+ *   lists:    jep_add_object, jep_get_element
+ *   buffers:  jep_create_buffer, jep_buffer_bytes, jep_buffer_size,
+ *             jep_set_buffer_byte, jep_get_bytes
+ *   memory:   jep_pool_alloc, jep_pool_free
+ *   strings:  the functions of stringbuilder.h
+ */
+int jep_api_version();
+
+#endif
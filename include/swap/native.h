@@ -47,15 +47,46 @@ typedef jep_obj* (*jep_func)(jep_obj*, jep_obj*);
 #endif
 
 /**
- * calls a native function
+ * a natively implemented function that is linked into the interpreter.
+ * when SWAP_STATIC_NATIVE is defined, the functions of SwapNative.c
+ * are found in a table of these instead of in the shared library.
  */
-jep_obj* jep_call_native(const char* ident, jep_obj* args);
+typedef struct Native
+{
+	const char* ident; /* identifier without the jep_ prefix */
+	jep_func func;     /* implementation                     */
+} jep_native;
+
+#ifdef SWAP_STATIC_NATIVE
+/**
+ * the built in native functions, sorted by identifier
+ */
+extern const jep_native jep_natives[];
+extern const int jep_native_count;
+#endif
 
 /**
  * calls a function from a shared library
  */
 jep_obj* jep_call_shared(jep_lib lib, const char* ident, jep_obj* args, jep_obj* list);
 
+/**
+ * gets the implementation of a native function.
+ * built in functions are looked up first, then the shared library.
+ */
+jep_func jep_get_native(jep_lib lib, const char* ident);
+
+/**
+ * loads the native shared library from the directory of the executable
+ */
+jep_lib jep_load_native_lib();
+
+/**
+ * frees the extension library that was loaded for functions
+ * that are not built in
+ */
+void jep_free_extensions();
+
 /**
  * loads a shared library
  */
@@ -25,11 +25,14 @@
 #include "swap/ast.h"
 #include "swap/socket.h"
 #include "swap/thread.h"
+#include "swap/table.h"
+#include "swap/pool.h"
 
 /* return flags */
 #define JEP_RETURN 1
 #define JEP_EXCEPTION 2
 #define JEP_RETURNED 4
+#define JEP_TAIL_CALL 8 /* the arguments of a call to the returning function */
 
 /* types of jep_objects */
 #define JEP_BYTE 1
@@ -51,6 +54,7 @@
 #define JEP_STRUCTDEF 17
 #define JEP_THREAD 18
 #define JEP_LIBRARY 19
+#define JEP_BUFFER 20
 
 /* file modes */
 #define JEP_READ 1
@@ -61,25 +65,58 @@
 #define JEP_APPEND_BINARY 6
 
 /**
- * a structure representing all objects and lists of objects
+ * the value of a scalar, stored inside of its object
+ */
+typedef union Immediate
+{
+	int i;           /* int                           */
+	long l;          /* long                          */
+	double d;        /* double                        */
+	unsigned char b; /* byte                          */
+	char c;          /* character                     */
+	void *f;         /* native function implementation */
+} jep_imm;
+
+/**
+ * a structure representing all objects and lists of objects.
+ * the val of a scalar points to its imm, so it can still be
+ * accessed as *(int *)(o->val) without any allocation.
+ * the imm of a native function holds its implementation.
  */
 typedef struct Object
 {
-	char *ident;		 /* identifier                    */
+	char *ident;		 /* identifier (interned)         */
 	void *val;			 /* stored value                  */
+	jep_imm imm;         /* value of a scalar             */
 	int type;			 /* type of object                */
+	int refs;            /* number of owners of a list    */
 	struct Object *prev; /* previous object               */
 	struct Object *next; /* next object                   */
 	struct Object *head; /* beginning of list             */
 	struct Object *tail; /* end of list                   */
 	int size;            /* number of objects in the list */
+	struct Object **cells; /* objects in the list by index */
 	unsigned char ret;   /* return flag                   */
+	unsigned char shared; /* whether a string is shared   */
 	int index;           /* index in an array             */
 	int mod;             /* modifier flags                */
 	char *array_ident;   /* array identifier              */
 	struct Object *self; /* the actual object             */
+	struct ASTNode *shape; /* member list of a struct definition */
 } jep_obj;
 
+/**
+ * the header of a packed buffer of bytes.
+ * the bytes are stored directly after the header, and
+ * are shared by copies of a buffer until one of them
+ * is modified.
+ */
+typedef struct Buffer
+{
+	int refs; /* number of objects using the bytes */
+	int size; /* number of bytes                   */
+} jep_buf;
+
 /**
  * a structre representing a file for file io
  */
@@ -100,6 +137,50 @@ typedef struct File
 	unsigned int refs; /* amount of objects referencing this  */
 } jep_file;
 
+/**
+ * a structure representing the slots of a function call
+ */
+typedef struct Frame
+{
+	jep_obj **slots;      /* objects bound to resolved identifiers */
+	int size;             /* number of slots                       */
+	struct Frame *parent; /* frame of the calling function         */
+	struct ASTNode *body; /* statements of the function's body     */
+} jep_frame;
+
+/* number of nested function calls allowed by default */
+#define JEP_MAX_DEPTH 5000
+
+/* C stack left for the work done inside the deepest call */
+#define JEP_STACK_RESERVE (256 * 1024)
+
+/* C stack assumed when the system doesn't limit it */
+#define JEP_STACK_DEFAULT (8 * 1024 * 1024)
+
+/**
+ * a structure representing the state of the main list.
+ * it is stored as the value of the main list.
+ */
+typedef struct Environment
+{
+	jep_table *globals; /* objects at the top level of the main list */
+	jep_frame *frame;   /* frame of the function being called        */
+	int depth;          /* number of function calls in progress      */
+	int max_depth;      /* number of calls that throws an exception  */
+	char *stack_base;   /* C stack address where evaluation started  */
+	size_t stack_size;  /* C stack that nested calls may use         */
+} jep_env;
+
+/**
+ * statistics of the values given to objects
+ */
+typedef struct CopyStats
+{
+	long copies; /* values copied into another object      */
+	long moves;  /* values handed over to another object   */
+	long bytes;  /* bytes of values duplicated by copies   */
+} jep_copy_stats;
+
 /**
  * allocates memory for a new object
  */
@@ -110,16 +191,81 @@ jep_obj *jep_create_object();
  */
 void jep_destroy_object(jep_obj *obj);
 
+/**
+ * stores an int inside of an object
+ */
+void jep_set_int(jep_obj *o, int n);
+
+/**
+ * stores a long inside of an object
+ */
+void jep_set_long(jep_obj *o, long n);
+
+/**
+ * stores a double inside of an object
+ */
+void jep_set_double(jep_obj *o, double n);
+
+/**
+ * stores a byte inside of an object
+ */
+void jep_set_byte(jep_obj *o, unsigned char n);
+
+/**
+ * stores a character inside of an object
+ */
+void jep_set_char(jep_obj *o, char n);
+
 /**
  * creates a string representation of an object
  */
 char *jep_to_string(jep_obj *o);
 
 /**
- * converts an object into an array of bytes
+ * gets the number of objects using the string of an object,
+ * or 0 if the string is not shared
+ */
+int jep_string_refs(jep_obj *o);
+
+/**
+ * appends characters to the string of an object in place.
+ * the string must not be used by any other object.
+ */
+void jep_append_chars(jep_obj *o, const char *s);
+
+/**
+ * gives an object a shared string with room for a number of characters
+ * and returns the characters, so that they can be written in place
+ */
+char *jep_string_buffer(jep_obj *o, size_t len);
+
+/**
+ * converts an object into a buffer of bytes
  */
 jep_obj *jep_get_bytes(jep_obj *o);
 
+/**
+ * creates a buffer object holding a copy of some bytes.
+ * if bytes is NULL, the buffer is filled with zeros.
+ */
+jep_obj *jep_create_buffer(const unsigned char *bytes, int size);
+
+/**
+ * gets the bytes of a buffer object
+ */
+unsigned char *jep_buffer_bytes(jep_obj *o);
+
+/**
+ * gets the number of bytes in a buffer object
+ */
+int jep_buffer_size(jep_obj *o);
+
+/**
+ * changes a byte of a buffer object, giving it its
+ * own copy of the bytes if they are shared
+ */
+void jep_set_buffer_byte(jep_obj *o, int index, unsigned char b);
+
 /**
  * compares the values of two objects
  */
@@ -130,6 +276,12 @@ int jep_compare_object(jep_obj *a, jep_obj *b);
  */
 void jep_add_object(jep_obj *list, jep_obj *o);
 
+/**
+ * gets the object at an index of a list,
+ * or NULL if the index is out of bounds
+ */
+jep_obj *jep_get_element(jep_obj *list, int index);
+
 /**
  * removes the last object from a list
  */
@@ -141,10 +293,67 @@ void jep_pop_object(jep_obj *list);
 jep_obj *jep_get_object(const char *ident, jep_obj *list);
 
 /**
- * copies the value of one obect into another
+ * retreives an object from the top level of the main list
+ */
+jep_obj *jep_get_global(const char *ident, jep_obj *list);
+
+/**
+ * allocates memory for the state of the main list
+ */
+jep_env *jep_create_env();
+
+/**
+ * frees the memory used by the state of the main list
+ */
+void jep_destroy_env(jep_env *env);
+
+/**
+ * retreives the object of an identifier, using the slot
+ * of the current frame if the identifier was resolved
+ */
+jep_obj *jep_lookup(jep_ast_node *node, jep_obj *list);
+
+/**
+ * binds an object to the slot of a resolved identifier
+ */
+void jep_bind_slot(jep_ast_node *node, jep_obj *list, jep_obj *o);
+
+/**
+ * copies the value of one obect into another.
+ * strings, and the lists of arrays and structs, are shared
+ * by the copies until one of them is modified.
  */
 void jep_copy_object(jep_obj *dest, jep_obj *src);
 
+/**
+ * hands the value of a temporary object over to another object
+ * without copying it. src is left without a value, so it can be
+ * destroyed without affecting dest.
+ */
+void jep_move_object(jep_obj *dest, jep_obj *src);
+
+/**
+ * gets the statistics of the values copied and moved between objects
+ */
+jep_copy_stats jep_get_copy_stats();
+
+/**
+ * writes the statistics of copied and moved values to standard out
+ */
+void jep_print_copy_stats();
+
+/**
+ * copies the value of one object into another without sharing
+ * the lists of any arrays or structs that it contains
+ */
+void jep_clone_object(jep_obj *dest, jep_obj *src);
+
+/**
+ * gives the owner of a copied array or struct its own list
+ * before one of its elements is modified through the copy
+ */
+void jep_unshare(jep_obj *o);
+
 /**
  * copies the main list
  * this is basically the same as copying a regular list,
@@ -177,6 +386,17 @@ jep_obj *jep_character(const char *s);
  */
 jep_obj *jep_string(const char *s);
 
+/**
+ * converts a literal into the value that is kept in the constant pool.
+ * the characters of a string are shared by every copy of the value.
+ */
+jep_obj *jep_constant(jep_ast_node *node);
+
+/**
+ * gets a copy of the value of a literal from the constant pool
+ */
+jep_obj *jep_literal(jep_ast_node *node);
+
 /**
  * convertes an ast into an array
  */
@@ -193,14 +413,13 @@ void jep_print_object(jep_obj *obj);
 void jep_print_list(jep_obj *list);
 
 /**
- * removes the scope list off the tail of a list
+ * destroys the objects in a scope so it can be used again
  */
-void jep_remove_scope(jep_obj *list);
+void jep_clear_scope(jep_obj *scope);
 
 /**
- * writes the values of the static integers incremented
- * by the object creation and destruction functions to standard out
+ * removes the scope list off the tail of a list
  */
-void print_call_counts();
+void jep_remove_scope(jep_obj *list);
 
 #endif
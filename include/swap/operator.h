@@ -23,118 +23,256 @@
 /**
  * evaluates an AST node
  */
-jep_obj* jep_evaluate(jep_ast_node ast, jep_obj* list);
+jep_obj* jep_evaluate(jep_ast_node* ast, jep_obj* list);
+
+/**
+ * evaluates an identifier
+ */
+jep_obj* jep_identifier(jep_ast_node* node, jep_obj* list);
+
+/**
+ * evaluates a binary operator that specializes itself for two ints.
+ * variables and literals are read in place instead of being copied.
+ */
+jep_obj* jep_quick_int(jep_ast_node* node, jep_obj* list);
 
 /**
  * evaluates an addition expression
  */
 jep_obj* jep_add(jep_ast_node node, jep_obj* list);
 
+/**
+ * adds two objects
+ */
+jep_obj* jep_add_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates subtraction or negation
  */
 jep_obj* jep_sub(jep_ast_node node, jep_obj* list);
 
+/**
+ * subtracts one object from another
+ */
+jep_obj* jep_sub_objects(jep_obj* l, jep_obj* r);
+
+/**
+ * negates an object
+ */
+jep_obj* jep_neg_object(jep_obj* l);
+
 /**
  * evaluates a multiplication expression
  */
 jep_obj* jep_mul(jep_ast_node node, jep_obj* list);
 
+/**
+ * multiplies two objects
+ */
+jep_obj* jep_mul_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a division expression
  */
 jep_obj* jep_div(jep_ast_node node, jep_obj* list);
 
+/**
+ * divides two objects
+ */
+jep_obj* jep_div_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a modulus expression
  */
 jep_obj* jep_modulus(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a modulus operation on two objects
+ */
+jep_obj* jep_modulus_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a less than expression
  */
 jep_obj* jep_less(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects using less than
+ */
+jep_obj* jep_less_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a greater than expression
  */
 jep_obj* jep_greater(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects using greater than
+ */
+jep_obj* jep_greater_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a less than or equal to expression
  */
 jep_obj* jep_lorequal(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects using less than or equal to
+ */
+jep_obj* jep_lorequal_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a greater than or equal to expression
  */
 jep_obj* jep_gorequal(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects using greater than or equal to
+ */
+jep_obj* jep_gorequal_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates an equivalence expression
  */
 jep_obj* jep_equiv(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects for equivalence
+ */
+jep_obj* jep_equiv_objects(jep_obj* l, jep_obj* r);
+
 /**
  * evaluates a not equivalence expression
  */
 jep_obj* jep_noteq(jep_ast_node node, jep_obj* list);
 
+/**
+ * compares two objects for non-equivalence
+ */
+jep_obj* jep_noteq_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a not operation
  */
 jep_obj* jep_not(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a not operation on an object
+ */
+jep_obj* jep_not_object(jep_obj* l);
+
 /**
  * performs a logical and operation
  */
 jep_obj* jep_and(jep_ast_node node, jep_obj* list);
 
+/**
+ * checks whether the left operand decides a logical and operation
+ */
+jep_obj* jep_and_left(jep_obj* l);
+
+/**
+ * performs a logical and operation on two objects
+ */
+jep_obj* jep_and_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a logical or operation
  */
 jep_obj* jep_or(jep_ast_node node, jep_obj* list);
 
+/**
+ * checks whether the left operand decides a logical or operation
+ */
+jep_obj* jep_or_left(jep_obj* l);
+
+/**
+ * performs a logical or operation on two objects
+ */
+jep_obj* jep_or_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a bitwise operation
  */
 jep_obj* jep_bitand(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a bitwise and operation on two objects
+ */
+jep_obj* jep_bitand_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a bitwise or operation
  */
 jep_obj* jep_bitor(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a bitwise or operation on two objects
+ */
+jep_obj* jep_bitor_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a bitwise xor operation
  */
 jep_obj* jep_bitxor(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a bitwise xor operation on two objects
+ */
+jep_obj* jep_bitxor_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a left bit shift operation
  */
 jep_obj* jep_lshift(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a left bit shift operation on two objects
+ */
+jep_obj* jep_lshift_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs a right bit shift operation
  */
 jep_obj* jep_rshift(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a right bit shift operation on two objects
+ */
+jep_obj* jep_rshift_objects(jep_obj* l, jep_obj* r);
+
 /**
  * performs an increment on an integer
  */
 jep_obj* jep_inc(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs an increment on an object
+ */
+jep_obj* jep_inc_object(jep_obj* obj, int postfix);
+
 /**
  * performs a decrement on an integer
  */
 jep_obj* jep_dec(jep_ast_node node, jep_obj* list);
 
+/**
+ * performs a decrement on an object
+ */
+jep_obj* jep_dec_object(jep_obj* obj, int postfix);
+
 /**
  * performs an addition assignmnet
  */
 jep_obj* jep_add_assign(jep_ast_node node, jep_obj* list);
 
+/**
+ * adds an object to another and assigns the sum to it.
+ * a string that is not used by any other object is
+ * appended to in place.
+ */
+jep_obj* jep_add_assign_objects(jep_obj* l, jep_obj* r, jep_ast_node* target, jep_obj* list);
+
 /**
  * performs a subtraction assignment
  */
@@ -185,11 +323,48 @@ jep_obj *jep_rshift_assign(jep_ast_node node, jep_obj *list);
  */
 jep_obj* jep_assign(jep_ast_node node, jep_obj* list);
 
+/**
+ * assigns one object to another
+ */
+jep_obj* jep_assign_objects(jep_obj* l, jep_obj* r, jep_ast_node* target, jep_obj* list);
+
 /**
  * evaluates the contents of a set of parentheses
  */
 jep_obj* jep_paren(jep_ast_node node, jep_obj* list);
 
+/**
+ * calls a function with a list of arguments
+ */
+jep_obj* jep_call(jep_obj* func, jep_obj* arg_list, jep_obj* list);
+
+/**
+ * calls a function from a return statement, leaving a call
+ * of the function being returned from to jep_call
+ */
+jep_obj* jep_tail_call(jep_obj* func, jep_obj* arg_list, jep_obj* list);
+
+/**
+ * gives the arguments of a call the names of the function's parameters,
+ * returning 0 if the numbers of arguments and parameters differ
+ */
+int jep_bind_arguments(jep_obj* func, jep_obj* arg_list);
+
+/**
+ * adds the slots and the scope of a call to a function's body
+ */
+void jep_enter_frame(jep_frame* frame, jep_ast_node* body, jep_obj* arg_list, jep_obj* list);
+
+/**
+ * removes the slots and the scope of a call
+ */
+void jep_leave_frame(jep_frame* frame, jep_obj* list);
+
+/**
+ * creates an exception with a message
+ */
+jep_obj* jep_exception(const char* message);
+
 /**
  * evaluates the contents of a set of curly braces
  */
@@ -200,6 +375,21 @@ jep_obj* jep_brace(jep_ast_node node, jep_obj* list);
  */
 jep_obj* jep_subscript(jep_ast_node node, jep_obj* list);
 
+/**
+ * creates an array of a certain size
+ */
+jep_obj* jep_sized_array(jep_obj* size);
+
+/**
+ * creates an array from the elements in curly braces
+ */
+jep_obj* jep_array_literal(jep_ast_node* node, jep_obj* list);
+
+/**
+ * accesses an element of an array
+ */
+jep_obj* jep_subscript_objects(jep_obj* index, jep_obj* array);
+
 /**
  * gets the actual data member from a struct
  */
@@ -250,6 +440,12 @@ jep_obj* jep_switch(jep_ast_node node, jep_obj* list);
  */
 jep_obj* jep_for(jep_ast_node node, jep_obj* list);
 
+/**
+ * increments the index of a counted for loop and compares it
+ * with the limit, returning the value of the loop's condition
+ */
+int jep_count(jep_ast_node* node, jep_obj* list);
+
 /**
  * evaluates a while loop
  */
@@ -285,6 +481,11 @@ jep_obj* jep_new(jep_ast_node node, jep_obj* list);
  */
 jep_obj* jep_member(jep_ast_node node, jep_obj* list);
 
+/**
+ * accesses a member of a struct that has been evaluated
+ */
+jep_obj* jep_member_object(jep_obj* struc, jep_ast_node* node);
+
 /**
  * evaluates a modifier chain
  */
@@ -0,0 +1,34 @@
+/*
+	Functions for simplifying an abstract syntax tree before it is run
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_OPTIMIZER_H
+#define JEP_OPTIMIZER_H
+
+#include "swap/operator.h"
+
+/**
+ * simplifies an AST before it is run. operations on literals are
+ * replaced by their results, the globals that are declared const
+ * are replaced by their values, if statements whose conditions are
+ * constant are reduced to the branch that is taken, and statements
+ * that follow a return or throw in a block are removed.
+ * the text of new literals is interned in the token stream
+ * and their values are added to the constant pool.
+ */
+void jep_optimize(jep_ast_node* root, jep_token_stream* ts, jep_obj* constants);
+
+#endif
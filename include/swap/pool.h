@@ -0,0 +1,72 @@
+/*
+	Functions for allocating small blocks of memory from slabs
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_POOL_H
+#define JEP_POOL_H
+
+#include <stdlib.h>
+
+/* blocks are rounded up to a multiple of this size */
+#define JEP_POOL_ALIGN 16
+
+/* the largest block taken from a slab */
+#define JEP_POOL_MAX 256
+
+/* number of block sizes, each with its own free list */
+#define JEP_POOL_CLASSES (JEP_POOL_MAX / JEP_POOL_ALIGN)
+
+/* number of bytes requested from malloc for each slab */
+#define JEP_SLAB_SIZE 16384
+
+/**
+ * allocation statistics
+ */
+typedef struct PoolStats
+{
+	long live;  /* blocks currently allocated   */
+	long peak;  /* most blocks allocated at once */
+	long total; /* blocks allocated since start  */
+} jep_pool_stats;
+
+/**
+ * allocates a block of memory.
+ * blocks larger than JEP_POOL_MAX are allocated with malloc.
+ */
+void *jep_pool_alloc(size_t size);
+
+/**
+ * returns a block of memory to the free list of its size.
+ * the size must be the same one that was used to allocate it.
+ */
+void jep_pool_free(void *block, size_t size);
+
+/**
+ * gets the allocation statistics of all blocks
+ */
+jep_pool_stats jep_get_pool_stats();
+
+/**
+ * writes the allocation statistics of each block size to standard out
+ */
+void jep_print_pool_stats();
+
+/**
+ * frees the memory used by all slabs
+ */
+void jep_destroy_pool();
+
+#endif /* JEP_POOL_H */
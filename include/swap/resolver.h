@@ -0,0 +1,58 @@
+/*
+	Functions for binding identifiers to the slots of function frames
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_RESOLVER_H
+#define JEP_RESOLVER_H
+
+#include "swap/object.h"
+
+/**
+ * binds the arguments and local variables of each function
+ * in an AST to the slots of the function's frame, marks
+ * the subscripts and data member accesses that are assigned to,
+ * marks the assignments whose values are never used,
+ * marks the loops whose iterations don't need a scope,
+ * marks the for loops that count an index up to a limit,
+ * marks the returns of calls to the function they are in,
+ * and builds the jump tables of switch statements
+ */
+void jep_resolve(jep_ast_node* root);
+
+/**
+ * finds the block of a switch statement that a value jumps to,
+ * or NULL if there isn't a matching label or a default label
+ */
+jep_ast_node* jep_find_case(jep_case_table* table, jep_obj* value);
+
+/**
+ * frees the jump tables of the switch statements in an AST
+ */
+void jep_destroy_cases(jep_ast_node* node);
+
+/**
+ * checks if evaluating a node could add an object to the innermost scope
+ */
+int jep_declares(jep_ast_node* node);
+
+/**
+ * converts each literal in an AST into a value in the constant pool,
+ * so that it is not converted again every time it is evaluated.
+ * the error flag of the root is set if a literal is invalid.
+ */
+jep_obj* jep_create_constants(jep_ast_node* root);
+
+#endif
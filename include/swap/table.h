@@ -0,0 +1,85 @@
+/*
+	A hash table that maps identifiers to values
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_TABLE_H
+#define JEP_TABLE_H
+
+#include <stdlib.h>
+
+/**
+ * an entry in a hash table
+ */
+typedef struct Entry
+{
+	const char *key;   /* the identifier           */
+	int len;           /* number of chars in key   */
+	unsigned int hash; /* hash code of the key     */
+	void *val;         /* the value of the entry   */
+} jep_entry;
+
+/**
+ * a hash table with open addressing
+ */
+typedef struct Table
+{
+	jep_entry *entries; /* the entries                        */
+	int size;           /* number of keys in the table        */
+	int cap;            /* number of entries (a power of two) */
+} jep_table;
+
+/**
+ * allocates memory for a new hash table
+ */
+jep_table *jep_create_table();
+
+/**
+ * frees the memory used by a hash table
+ */
+void jep_destroy_table(jep_table *table);
+
+/**
+ * computes the hash code of an identifier
+ */
+unsigned int jep_hash(const char *key);
+
+/**
+ * computes the hash code of some characters, which may include '\0'
+ */
+unsigned int jep_hash_slice(const char *key, int len);
+
+/**
+ * retreives the value associated with a key
+ */
+void *jep_table_get(jep_table *table, const char *key);
+
+/**
+ * associates a value with a key, replacing any previous value
+ */
+void jep_table_put(jep_table *table, const char *key, void *val);
+
+/**
+ * retreives the value associated with a key of some length
+ */
+void *jep_table_get_slice(jep_table *table, const char *key, int len);
+
+/**
+ * associates a value with a key of some length
+ */
+void jep_table_put_slice(jep_table *table, const char *key, int len,
+	void *val);
+
+#endif /* JEP_TABLE_H */
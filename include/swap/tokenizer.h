@@ -23,6 +23,7 @@
 #include <string.h>
 #include <ctype.h>
 #include "swap/stringbuilder.h"
+#include "swap/table.h"
 
 /* token types */
 #define T_END 0
@@ -137,6 +138,7 @@ typedef struct TokenStream
 	int dir_cap;    /* capacity for directive tokens        */
 	int dir_size;   /* amount of directive tokens           */
 	jep_token* dir; /* the directive tokens                 */
+	jep_table* names; /* interned identifiers and strings   */
 }jep_token_stream;
 
 /**
@@ -174,6 +176,13 @@ void jep_append_directive(jep_token_stream* ts, jep_token d);
  */
 int jep_has_directive(jep_token_stream* ts, const char* dir);
 
+/**
+ * gets the canonical copy of an identifier or string.
+ * all interned copies of the same text share one pointer,
+ * so they can be compared with ==
+ */
+char* jep_intern(jep_token_stream* ts, const char* s);
+
 /**
  * tokenizes the contents of a file
  */
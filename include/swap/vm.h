@@ -0,0 +1,28 @@
+/*
+	Functions for executing bytecode
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef JEP_VM_H
+#define JEP_VM_H
+
+#include "swap/compiler.h"
+
+/**
+ * executes a chunk of bytecode
+ */
+jep_obj* jep_execute(jep_chunk* chunk, jep_obj* list);
+
+#endif
@@ -38,6 +38,10 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_len(jep_obj *args, jep_obj* list)
 		*(int *)(length->val) = obj->size;
 		break;
 
+	case JEP_BUFFER:
+		*(int *)(length->val) = jep_buffer_size(obj);
+		break;
+
 	default:
 		break;
 	}
@@ -126,6 +130,11 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_typeof(jep_obj *args, jep_obj* list)
 		strcpy(str, "reference");
 		break;
 
+	case JEP_BUFFER:
+		str = malloc(7);
+		strcpy(str, "buffer");
+		break;
+
 	case JEP_NULL:
 		str = malloc(5);
 		strcpy(str, "null");
@@ -513,7 +522,6 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_byte(jep_obj *args, jep_obj* list)
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_bytes(jep_obj *args, jep_obj* list)
 {
 	jep_obj *byte_obj = NULL;
-	char* str = NULL;
 
 	if (args == NULL || args->size != 1)
 	{
@@ -528,7 +536,7 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_bytes(jep_obj *args, jep_obj* list)
 
 	jep_obj *arg = args->head;
 
-	if (arg->type != JEP_STRING)
+	if (arg->type != JEP_STRING && arg->type != JEP_CHARACTER)
 	{
 		byte_obj = jep_create_object();
 		byte_obj->type = JEP_STRING;
@@ -539,32 +547,131 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_bytes(jep_obj *args, jep_obj* list)
 		return byte_obj;
 	}
 
-	byte_obj = jep_create_object();
-	byte_obj->type = JEP_ARRAY;
+	return jep_get_bytes(arg);
+}
+
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_buffer(jep_obj *args, jep_obj* list)
+{
+	jep_obj *o = NULL;
+
+	if (args == NULL || args->size != 1)
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(28);
+		strcpy(o->val, "invalid number of arguments");
+		((char*)(o->val))[27] = '\0';
+		return o;
+	}
+
+	jep_obj *size = args->head;
+
+	if (size->type != JEP_INT)
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(22);
+		strcpy(o->val, "invalid argument type");
+		((char*)(o->val))[21] = '\0';
+		return o;
+	}
 
-	str = (char*)arg->val;
+	if (*(int *)(size->val) < 0)
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(26);
+		strcpy(o->val, "array index out of bounds");
+		((char*)(o->val))[25] = '\0';
+		return o;
+	}
 
-	jep_obj *bytes = NULL;
-	unsigned int l = strlen(str);
+	return jep_create_buffer(NULL, *(int *)(size->val));
+}
 
-	bytes = jep_create_object();
-	bytes->type = JEP_LIST;
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_str(jep_obj *args, jep_obj* list)
+{
+	jep_obj *o = NULL;
 
-	unsigned int i;
-	for (i = 0; i < l; i++)
+	if (args == NULL || args->size != 1)
 	{
-		jep_obj *byte = jep_create_object();
-		byte->type = JEP_BYTE;
-		unsigned char *c = malloc(1);
-		*c = str[i];
-		byte->val = c;
-		jep_add_object(bytes, byte);
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(28);
+		strcpy(o->val, "invalid number of arguments");
+		((char*)(o->val))[27] = '\0';
+		return o;
 	}
 
-	byte_obj->size = bytes->size;
-	byte_obj->val = bytes;
+	jep_obj *arg = args->head;
+
+	o = jep_create_object();
+	o->type = JEP_STRING;
 
-	return byte_obj;
+	if (arg->type == JEP_BUFFER)
+	{
+		int n = jep_buffer_size(arg);
+		o->val = malloc(n + 1);
+		memcpy(o->val, jep_buffer_bytes(arg), n);
+		((char*)(o->val))[n] = '\0';
+	}
+	else
+	{
+		o->val = jep_to_string(arg);
+	}
+
+	return o;
+}
+
+SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_slice(jep_obj *args, jep_obj* list)
+{
+	jep_obj *o = NULL;
+
+	if (args == NULL || args->size != 3)
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(28);
+		strcpy(o->val, "invalid number of arguments");
+		((char*)(o->val))[27] = '\0';
+		return o;
+	}
+
+	jep_obj *buf = args->head;
+	jep_obj *start = buf->next;
+	jep_obj *end = start->next;
+
+	if (buf->type != JEP_BUFFER || start->type != JEP_INT || end->type != JEP_INT)
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(22);
+		strcpy(o->val, "invalid argument type");
+		((char*)(o->val))[21] = '\0';
+		return o;
+	}
+
+	int s = *(int *)(start->val);
+	int e = *(int *)(end->val);
+
+	if (s < 0 || e < s || e > jep_buffer_size(buf))
+	{
+		o = jep_create_object();
+		o->type = JEP_STRING;
+		o->ret = JEP_RETURN | JEP_EXCEPTION;
+		o->val = malloc(26);
+		strcpy(o->val, "array index out of bounds");
+		((char*)(o->val))[25] = '\0';
+		return o;
+	}
+
+	return jep_create_buffer(jep_buffer_bytes(buf) + s, e - s);
 }
 
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_write(jep_obj* args, jep_obj* list)
@@ -923,37 +1030,17 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_freadb(jep_obj* args, jep_obj* list)
 		return NULL;
 	}
 
-	jep_obj *byte_array = NULL;
-	jep_obj *bytes = NULL;
-	unsigned char *data = malloc(n);
-	size_t read = fread(data, n, 1, file_obj->file);
+	/* read directly into the memory of the buffer */
+	jep_obj *buffer = jep_create_buffer(NULL, n);
+	size_t read = fread(jep_buffer_bytes(buffer), n, 1, file_obj->file);
 
-	if (read)
+	if (!read)
 	{
-		byte_array = jep_create_object();
-		byte_array->type = JEP_ARRAY;
-
-		bytes = jep_create_object();
-		bytes->type = JEP_LIST;
-
-		int i;
-		for (i = 0; i < n; i++)
-		{
-			jep_obj *byte = jep_create_object();
-			byte->type = JEP_BYTE;
-			unsigned char *c = malloc(1);
-			*c = data[i];
-			byte->val = c;
-			jep_add_object(bytes, byte);
-		}
-
-		byte_array->size = bytes->size;
-		byte_array->val = bytes;
+		jep_destroy_object(buffer);
+		buffer = NULL;
 	}
 
-	free(data);
-
-	return byte_array;
+	return buffer;
 }
 
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_fwriteb(jep_obj* args, jep_obj* list)
@@ -994,6 +1081,16 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_fwriteb(jep_obj* args, jep_obj* list
 		printf("could not covnert data into binary\n");
 		return NULL;
 	}
+	else if (data->type == JEP_BUFFER)
+	{
+		/* write directly from the memory of the buffer */
+		size_t read = fwrite(jep_buffer_bytes(data), jep_buffer_size(data), 1, file_obj->file);
+		fflush(file_obj->file);
+
+		written = jep_create_object();
+		written->type = JEP_INT;
+		jep_set_int(written, (int)read);
+	}
 	else
 	{
 		byte_array = NULL;
@@ -1334,7 +1431,7 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_readSocket(jep_obj* args, jep_obj* l
 
 	/* dereference the buffer */
 	in_buffer = (jep_obj*)(in_buffer->val);
-	if (in_buffer->type != JEP_ARRAY)
+	if (in_buffer->type != JEP_ARRAY && in_buffer->type != JEP_BUFFER)
 	{
 		read = jep_create_object();
 		read->type = JEP_STRING;
@@ -1348,13 +1445,14 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_readSocket(jep_obj* args, jep_obj* l
 	file = (jep_file*)arg->val;
 	int n = *((int *)(size->val));
 
-	jep_obj *bytes = NULL;
-	unsigned char *data = malloc(n);
+	/* receive directly into the memory of a new buffer */
+	jep_obj *bytes = jep_create_buffer(NULL, n);
+	unsigned char *data = jep_buffer_bytes(bytes);
 	int result = jep_socket_receive(file->socket, data, n, 0);
 
 	if (result == JEP_SOCKET_ERROR)
 	{
-		free(data);
+		jep_destroy_object(bytes);
 
 		read = jep_create_object();
 		read->type = JEP_STRING;
@@ -1367,29 +1465,12 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_readSocket(jep_obj* args, jep_obj* l
 
 	if (result)
 	{
-		if (in_buffer->val != NULL)
-		{
-			jep_destroy_object((jep_obj*)in_buffer->val);
-		}
-		bytes = jep_create_object();
-		bytes->type = JEP_LIST;
-
-		int i;
-		for (i = 0; i < result; i++)
-		{
-			jep_obj *byte = jep_create_object();
-			byte->type = JEP_BYTE;
-			unsigned char *c = malloc(1);
-			*c = data[i];
-			byte->val = c;
-			jep_add_object(bytes, byte);
-		}
-
-		in_buffer->size = bytes->size;
-		in_buffer->val = bytes;
+		/* the buffer only holds the bytes that were read */
+		((jep_buf *)(bytes->val))->size = result;
+		jep_copy_object(in_buffer, bytes);
 	}
 
-	free(data);
+	jep_destroy_object(bytes);
 
 	read = jep_create_object();
 	read->type = JEP_INT;
@@ -1419,7 +1500,8 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_writeSocket(jep_obj* args, jep_obj*
 	jep_obj *out_buffer = arg->next;
 	jep_obj *size = arg->next->next;
 
-	if (arg->type != JEP_FILE || out_buffer->type != JEP_ARRAY || size->type != JEP_INT)
+	if (arg->type != JEP_FILE || (out_buffer->type != JEP_ARRAY && out_buffer->type != JEP_BUFFER)
+		|| size->type != JEP_INT)
 	{
 		read = jep_create_object();
 		read->type = JEP_STRING;
@@ -1433,6 +1515,21 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_writeSocket(jep_obj* args, jep_obj*
 	file = (jep_file*)arg->val;
 	int n = *((int *)(size->val));
 
+	if (out_buffer->type == JEP_BUFFER)
+	{
+		/* send directly from the memory of the buffer */
+		if (n > jep_buffer_size(out_buffer))
+		{
+			n = jep_buffer_size(out_buffer);
+		}
+
+		read = jep_create_object();
+		read->type = JEP_INT;
+		jep_set_int(read, jep_socket_send(file->socket, (char*)jep_buffer_bytes(out_buffer), n, 0));
+
+		return read;
+	}
+
 	jep_string_builder *sb = jep_create_string_builder();
 
 	jep_obj* element = ((jep_obj*)(out_buffer->val))->head;
@@ -1740,11 +1837,50 @@ SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_sleep(jep_obj* args, jep_obj* list)
 }
 
 /**
-* prints the number of times an an object was created in the native library
+* prints the allocation statistics of the native library
 */
 SWAPNATIVE_API jep_obj* SWAPNATIVE_CALL jep_print_native_call_count()
 {
-	print_call_counts();
+	jep_print_pool_stats();
 
 	return NULL;
 }
+
+#ifdef SWAP_STATIC_NATIVE
+/* the built in functions, sorted by identifier for jep_get_native */
+const jep_native jep_natives[] =
+{
+	{ "acceptSocket", jep_acceptSocket },
+	{ "bindSocket", jep_bindSocket },
+	{ "buffer", jep_buffer },
+	{ "byte", jep_byte },
+	{ "bytes", jep_bytes },
+	{ "char", jep_char },
+	{ "closeSocket", jep_closeSocket },
+	{ "connectSocket", jep_connectSocket },
+	{ "createSocket", jep_createSocket },
+	{ "createThread", jep_createThread },
+	{ "double", jep_double },
+	{ "fopen", jep_fopen },
+	{ "freadb", jep_freadb },
+	{ "freadln", jep_freadln },
+	{ "fwrite", jep_fwrite },
+	{ "fwriteb", jep_fwriteb },
+	{ "fwriteln", jep_fwriteln },
+	{ "int", jep_int },
+	{ "len", jep_len },
+	{ "listenSocket", jep_listenSocket },
+	{ "readSocket", jep_readSocket },
+	{ "readln", jep_readln },
+	{ "sleep", jep_sleep },
+	{ "slice", jep_slice },
+	{ "startThread", jep_startThread },
+	{ "str", jep_str },
+	{ "typeof", jep_typeof },
+	{ "write", jep_write },
+	{ "writeSocket", jep_writeSocket },
+	{ "writeln", jep_writeln },
+};
+
+const int jep_native_count = sizeof(jep_natives) / sizeof(jep_natives[0]);
+#endif
@@ -29,6 +29,15 @@ jep_ast_node *jep_create_ast_node()
 	node->array = 0;
 	node->loop = 0;
 	node->mod = 0;
+	node->code = NULL;
+	node->slot = -1;
+	node->slots = 0;
+	node->target = 0;
+	node->value = NULL;
+	node->shape = NULL;
+	node->member = -1;
+	node->quick = 0;
+	node->cases = NULL;
 	return node;
 }
 
@@ -0,0 +1,933 @@
+/*
+	Functions for compiling an abstract syntax tree into bytecode
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "swap/compiler.h"
+
+/* the state of a chunk that is being compiled */
+typedef struct Compiler
+{
+	jep_chunk *chunk; /* the chunk being compiled            */
+	jep_chunk *last;  /* the last chunk of the program       */
+	int sp;           /* current depth of the operand stack  */
+	int depth;        /* current number of nested scopes     */
+}jep_compiler;
+
+/* names of the operation codes */
+static const char *op_names[OP_COUNT] =
+{
+	"END", "NONE", "NULL", "NUMBER", "CHARACTER", "STRING", "LOAD", "DROP",
+	"ADD", "SUB", "MUL", "DIV", "MOD", "LESS", "GREATER", "LOREQUAL",
+	"GOREQUAL", "EQUIV", "NOTEQ", "BITAND", "BITOR", "BITXOR", "LSHIFT",
+	"RSHIFT", "NEG", "NOT", "AND_LEFT", "AND", "OR_LEFT", "OR", "ASSIGN",
+	"INC", "DEC", "FUNC", "CALL", "ARRAY", "SUBSCRIPT", "RETURN", "THROW",
+	"EVAL", "JUMP", "BRANCH", "LOOP", "NEXT", "PUSH_SCOPE", "POP_SCOPE",
+	"POP_BLOCK", "POP_LOOP", "POP_TOP", "CATCH", "CLEAR", "ADD_ASSIGN",
+	"COUNT_NEXT", "TAIL_CALL", "QUICK", "STORE", "MEMBER", "SWITCH"
+};
+
+/* change in the depth of the operand stack for each operation code */
+static const int op_effects[OP_COUNT] =
+{
+	0,  1,  1,  1,  1,  1,  1, -1, /* END ... DROP           */
+	-1, -1, -1, -1, -1, -1, -1, -1, /* ADD ... LOREQUAL       */
+	-1, -1, -1, -1, -1, -1, -1,     /* GOREQUAL ... LSHIFT    */
+	-1, 0,  0,  0,  -1, 0,  -1, -1, /* RSHIFT ... ASSIGN      */
+	0,  0,  1,  0,  0,  -1, 0,  0,  /* INC ... THROW          */
+	1,  0,  -1, -1, -1, 0,  0,      /* EVAL ... POP_SCOPE     */
+	-1, -1, -1, -1, 0,  -1,         /* POP_BLOCK ... ADD_ASSIGN */
+	0,  0,  1,  0,  0,  -1          /* COUNT_NEXT ... SWITCH  */
+};
+
+static void jep_compile_node(jep_compiler *c, jep_ast_node *node);
+
+/* creates an empty chunk */
+static jep_chunk *jep_create_chunk(const char *name)
+{
+	jep_chunk *chunk = malloc(sizeof(jep_chunk));
+
+	chunk->name = name;
+	chunk->size = 0;
+	chunk->cap = 32;
+	chunk->code = malloc(sizeof(jep_instr) * chunk->cap);
+	chunk->stack = 0;
+	chunk->scopes = 0;
+	chunk->next = NULL;
+
+	return chunk;
+}
+
+/* appends an instruction to the chunk being compiled */
+static int jep_emit(jep_compiler *c, int op, int a, int b, jep_ast_node *node)
+{
+	jep_chunk *chunk = c->chunk;
+
+	if (chunk->size >= chunk->cap)
+	{
+		chunk->cap += chunk->cap / 2;
+		chunk->code = realloc(chunk->code, sizeof(jep_instr) * chunk->cap);
+	}
+
+	chunk->code[chunk->size].op = op;
+	chunk->code[chunk->size].a = a;
+	chunk->code[chunk->size].b = b;
+	chunk->code[chunk->size].node = node;
+
+	c->sp += op_effects[op];
+	if (c->sp > chunk->stack)
+	{
+		chunk->stack = c->sp;
+	}
+
+	if (op == OP_PUSH_SCOPE || op == OP_CATCH)
+	{
+		c->depth++;
+		if (c->depth > chunk->scopes)
+		{
+			chunk->scopes = c->depth;
+		}
+	}
+	else if (op == OP_POP_SCOPE
+		|| ((op == OP_NEXT || op == OP_COUNT_NEXT) && b))
+	{
+		c->depth--;
+	}
+
+	return chunk->size++;
+}
+
+/*
+ * points every unresolved exit of a certain kind between start
+ * and the end of the chunk at the current instruction
+ */
+static void jep_patch_exits(jep_compiler *c, int start, int op)
+{
+	int i;
+	for (i = start; i < c->chunk->size; i++)
+	{
+		if (c->chunk->code[i].op == op && c->chunk->code[i].a < 0)
+		{
+			c->chunk->code[i].a = c->chunk->size;
+		}
+	}
+}
+
+/* compiles each argument in a comma-delimited sequence */
+static int jep_compile_sequence(jep_compiler *c, jep_ast_node *node)
+{
+	int count = 0;
+	int i;
+
+	for (i = 0; i < 2 && i < node->leaf_count; i++)
+	{
+		if (node->leaves[i].token.token_code == T_COMMA)
+		{
+			count += jep_compile_sequence(c, &(node->leaves[i]));
+		}
+		else
+		{
+			jep_compile_node(c, &(node->leaves[i]));
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/* compiles the contents of a set of parentheses */
+static void jep_compile_paren(jep_compiler *c, jep_ast_node *node)
+{
+	if (!node->token.postfix)
+	{
+		if (node->leaf_count == 1)
+		{
+			jep_compile_node(c, &(node->leaves[0]));
+		}
+		else
+		{
+			jep_emit(c, OP_NONE, 0, 0, node);
+		}
+		return;
+	}
+
+	if (node->leaf_count == 1)
+	{
+		/* function call without arguments */
+		jep_emit(c, OP_FUNC, 0, 0, &(node->leaves[0]));
+		jep_emit(c, OP_CALL, 0, 0, node);
+		c->sp--;
+	}
+	else if (node->leaf_count == 2)
+	{
+		jep_ast_node *args = &(node->leaves[0]);
+		int count;
+		int mode;
+
+		jep_emit(c, OP_FUNC, 0, 0, &(node->leaves[1]));
+
+		if (args->leaf_count >= 1 && args->token.token_code == T_COMMA)
+		{
+			count = jep_compile_sequence(c, args);
+			mode = 2;
+		}
+		else
+		{
+			jep_compile_node(c, args);
+			count = 1;
+			mode = 1;
+		}
+
+		jep_emit(c, OP_CALL, count, mode, node);
+		c->sp -= count + 1;
+	}
+	else
+	{
+		jep_emit(c, OP_EVAL, 0, 0, node);
+		return;
+	}
+
+	/* the return value of the function */
+	c->sp++;
+}
+
+/* compiles a compound assignment using a certain operation */
+static void jep_compile_compound(jep_compiler *c, jep_ast_node *node, int op)
+{
+	jep_compile_node(c, &(node->leaves[0]));
+	jep_compile_node(c, &(node->leaves[0]));
+	jep_compile_node(c, &(node->leaves[1]));
+	jep_emit(c, op, 0, 0, node);
+	jep_emit(c, OP_ASSIGN, 0, 0, &(node->leaves[0]));
+}
+
+/* compiles a block of code in curly braces */
+static void jep_compile_block(jep_compiler *c, jep_ast_node *node)
+{
+	int start = c->chunk->size;
+	int i;
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_compile_node(c, &(node->leaves[i]));
+		jep_emit(c, OP_POP_BLOCK, -1, c->depth, &(node->leaves[i]));
+	}
+
+	jep_emit(c, OP_NONE, 0, 0, node);
+	jep_patch_exits(c, start, OP_POP_BLOCK);
+}
+
+/* compiles the body of a statement within its own scope */
+static void jep_compile_scoped(jep_compiler *c, jep_ast_node *node)
+{
+	jep_emit(c, OP_PUSH_SCOPE, 0, 0, node);
+	jep_compile_node(c, node);
+	jep_emit(c, OP_POP_SCOPE, 0, 0, node);
+}
+
+/* compiles an if statement */
+static void jep_compile_if(jep_compiler *c, jep_ast_node *node)
+{
+	int branch;
+	int jumps[2] = { -1, -1 };
+
+	if (node->leaf_count < 2)
+	{
+		jep_emit(c, OP_NONE, 0, 0, node);
+		return;
+	}
+
+	jep_compile_node(c, &(node->leaves[0]));
+	branch = jep_emit(c, OP_BRANCH, -1, -1, node);
+
+	jep_compile_scoped(c, &(node->leaves[1]));
+	jumps[0] = jep_emit(c, OP_JUMP, -1, 0, node);
+	c->sp--;
+
+	c->chunk->code[branch].a = c->chunk->size;
+	if (node->leaf_count == 3)
+	{
+		jep_ast_node *els = &(node->leaves[2]);
+		if (els->token.token_code == T_IF)
+		{
+			jep_compile_if(c, els);
+			jumps[1] = jep_emit(c, OP_JUMP, -1, 0, els);
+			c->sp--;
+		}
+		else if (els->token.token_code == T_ELSE && els->leaf_count == 1)
+		{
+			jep_compile_scoped(c, &(els->leaves[0]));
+			jumps[1] = jep_emit(c, OP_JUMP, -1, 0, els);
+			c->sp--;
+		}
+	}
+
+	/* the condition was not an integer or there was no else */
+	c->chunk->code[branch].b = c->chunk->size;
+	if (jumps[1] < 0)
+	{
+		c->chunk->code[branch].a = c->chunk->size;
+	}
+	jep_emit(c, OP_NONE, 0, 0, node);
+
+	c->chunk->code[jumps[0]].a = c->chunk->size;
+	if (jumps[1] >= 0)
+	{
+		c->chunk->code[jumps[1]].a = c->chunk->size;
+	}
+}
+
+/* compiles the body of a loop */
+static void jep_compile_loop_body(jep_compiler *c, jep_ast_node *node, int depth)
+{
+	jep_compile_node(c, node);
+	jep_emit(c, OP_POP_LOOP, -1, depth, node);
+}
+
+/*
+ * adds the scope that is used by every iteration of a loop,
+ * returning whether the loop has one
+ */
+static int jep_compile_loop_scope(jep_compiler *c, jep_ast_node *node)
+{
+	if (node->loop & JEP_UNSCOPED)
+	{
+		return 0;
+	}
+
+	jep_emit(c, OP_PUSH_SCOPE, 0, 0, node);
+
+	return 1;
+}
+
+/* compiles a for loop */
+static void jep_compile_for(jep_compiler *c, jep_ast_node *node)
+{
+	jep_ast_node *head = &(node->leaves[0]);
+	jep_ast_node *index_node = NULL;
+	jep_ast_node *cond_node = NULL;
+	jep_ast_node *change_node = NULL;
+	int depth = c->depth;
+	int start;
+	int top;
+	int loop = -1;
+	int scoped;
+
+	if (node->loop & JEP_INDEX)
+	{
+		index_node = &(head->leaves[0]);
+	}
+
+	if (node->loop & JEP_CONDITION)
+	{
+		cond_node = &(head->leaves[node->loop & JEP_INDEX ? 1 : 0]);
+	}
+
+	if (node->loop & JEP_CHANGE)
+	{
+		if (node->loop & JEP_INDEX && node->loop & JEP_CONDITION)
+		{
+			change_node = &(head->leaves[2]);
+		}
+		else if (node->loop & JEP_INDEX || node->loop & JEP_CONDITION)
+		{
+			change_node = &(head->leaves[1]);
+		}
+		else
+		{
+			change_node = &(head->leaves[0]);
+		}
+	}
+
+	start = c->chunk->size;
+
+	if (index_node != NULL)
+	{
+		jep_compile_node(c, index_node);
+		jep_emit(c, OP_DROP, 0, 0, index_node);
+	}
+
+	if (cond_node != NULL)
+	{
+		jep_compile_node(c, cond_node);
+		loop = jep_emit(c, OP_LOOP, -1, 0, cond_node);
+	}
+
+	scoped = jep_compile_loop_scope(c, node);
+	top = c->chunk->size;
+
+	if (node->leaf_count == 2)
+	{
+		jep_compile_loop_body(c, &(node->leaves[1]), depth);
+	}
+
+	if (node->loop & JEP_COUNTED)
+	{
+		/* the index is incremented and compared without any objects */
+		jep_emit(c, OP_COUNT_NEXT, top, scoped, node);
+		c->chunk->code[loop].a = c->chunk->size;
+		jep_emit(c, OP_NONE, 0, 0, node);
+		jep_patch_exits(c, start, OP_POP_LOOP);
+		return;
+	}
+
+	if (change_node != NULL)
+	{
+		jep_compile_node(c, change_node);
+		jep_emit(c, OP_DROP, 0, 0, change_node);
+	}
+
+	if (cond_node != NULL)
+	{
+		jep_compile_node(c, cond_node);
+		jep_emit(c, OP_NEXT, top, scoped, cond_node);
+		c->chunk->code[loop].a = c->chunk->size;
+		jep_emit(c, OP_NONE, 0, 0, node);
+	}
+	else
+	{
+		/* a missing condition never ends the loop */
+		jep_emit(c, OP_NONE, 0, 0, node);
+		jep_emit(c, OP_NEXT, top, scoped, node);
+
+		/* the loop can only be left by returning a value */
+		c->sp++;
+	}
+
+	jep_patch_exits(c, start, OP_POP_LOOP);
+}
+
+/* compiles a while loop */
+static void jep_compile_while(jep_compiler *c, jep_ast_node *node)
+{
+	jep_ast_node *cond_node = &(node->leaves[0].leaves[0]);
+	int depth = c->depth;
+	int start = c->chunk->size;
+	int loop;
+	int top;
+	int scoped;
+
+	jep_compile_node(c, cond_node);
+	loop = jep_emit(c, OP_LOOP, -1, 0, cond_node);
+
+	scoped = jep_compile_loop_scope(c, node);
+	top = c->chunk->size;
+
+	if (node->leaf_count == 2)
+	{
+		jep_compile_loop_body(c, &(node->leaves[1]), depth);
+	}
+
+	jep_compile_node(c, cond_node);
+	jep_emit(c, OP_NEXT, top, scoped, cond_node);
+
+	c->chunk->code[loop].a = c->chunk->size;
+	jep_emit(c, OP_NONE, 0, 0, node);
+
+	jep_patch_exits(c, start, OP_POP_LOOP);
+}
+
+/*
+ * compiles a switch statement that has a jump table.
+ * the switch instruction is followed by a jump to each block, and
+ * it takes the jump whose node is the block that the value selects.
+ */
+static void jep_compile_switch(jep_compiler *c, jep_ast_node *node)
+{
+	jep_ast_node *body = &(node->leaves[1]);
+	int scoped = !(node->loop & JEP_UNSCOPED);
+	int table;
+	int sp;
+	int i;
+
+	jep_compile_node(c, &(node->leaves[0].leaves[0]));
+	table = jep_emit(c, OP_SWITCH, -1, body->leaf_count, node);
+	sp = c->sp;
+
+	for (i = 0; i < body->leaf_count; i++)
+	{
+		jep_ast_node *group = &(body->leaves[i]);
+		jep_ast_node *block = group;
+		if (group->token.token_code != T_DEFAULT)
+		{
+			block = &(group->leaves[group->leaf_count - 1]);
+		}
+		jep_emit(c, OP_JUMP, -1, 0, block);
+	}
+
+	for (i = 0; i < body->leaf_count; i++)
+	{
+		c->chunk->code[table + 1 + i].a = c->chunk->size;
+
+		c->sp = sp;
+		if (scoped)
+		{
+			jep_emit(c, OP_PUSH_SCOPE, 0, 0, node);
+		}
+		jep_compile_block(c, c->chunk->code[table + 1 + i].node);
+		if (scoped)
+		{
+			jep_emit(c, OP_POP_SCOPE, 0, 0, node);
+		}
+		jep_emit(c, OP_JUMP, -1, 0, node);
+	}
+
+	/* the value didn't select a block */
+	c->sp = sp;
+	c->chunk->code[table].a = c->chunk->size;
+	jep_emit(c, OP_NONE, 0, 0, node);
+
+	for (i = table + 1 + body->leaf_count; i < c->chunk->size; i++)
+	{
+		if (c->chunk->code[i].op == OP_JUMP && c->chunk->code[i].a < 0
+			&& c->chunk->code[i].node == node)
+		{
+			c->chunk->code[i].a = c->chunk->size;
+		}
+	}
+}
+
+/* compiles a try/catch block */
+static void jep_compile_try(jep_compiler *c, jep_ast_node *node)
+{
+	jep_ast_node *try_body = &(node->leaves[0]);
+	jep_ast_node *ex = &(node->leaves[1].leaves[0]);
+	jep_ast_node *catch_body = &(node->leaves[1].leaves[1]);
+	int catch;
+
+	jep_compile_scoped(c, try_body);
+
+	/* the catch block adds its own scope */
+	catch = jep_emit(c, OP_CATCH, -1, 0, ex);
+	jep_compile_node(c, catch_body);
+	jep_emit(c, OP_POP_SCOPE, 0, 0, catch_body);
+	jep_emit(c, OP_CLEAR, 0, 0, node);
+
+	c->chunk->code[catch].a = c->chunk->size;
+}
+
+/* checks if an operand can be read in place by a quickened operator */
+static int jep_in_place(jep_ast_node *node)
+{
+	return node->token.type == T_IDENTIFIER || node->value != NULL;
+}
+
+/*
+ * checks if an operation can be applied to its operands without
+ * pushing copies of them, using the same int specialization as the
+ * tree walker
+ */
+static int jep_quickens(jep_ast_node *node, int op)
+{
+	switch (op)
+	{
+	case OP_ADD:
+	case OP_SUB:
+	case OP_MUL:
+	case OP_LESS:
+	case OP_GREATER:
+	case OP_LOREQUAL:
+	case OP_GOREQUAL:
+	case OP_EQUIV:
+	case OP_NOTEQ:
+		return jep_in_place(&(node->leaves[0]))
+			&& jep_in_place(&(node->leaves[1]));
+	default:
+		return 0;
+	}
+}
+
+/* compiles a binary operation */
+static void jep_compile_binary(jep_compiler *c, jep_ast_node *node, int op)
+{
+	if (node->leaf_count != 2)
+	{
+		jep_emit(c, OP_NONE, 0, 0, node);
+		return;
+	}
+
+	if (jep_quickens(node, op))
+	{
+		jep_emit(c, OP_QUICK, 0, 0, node);
+		return;
+	}
+
+	jep_compile_node(c, &(node->leaves[0]));
+	jep_compile_node(c, &(node->leaves[1]));
+	jep_emit(c, op, 0, 0, node);
+}
+
+/* compiles a unary operation */
+static void jep_compile_unary(jep_compiler *c, jep_ast_node *node, int op, int a)
+{
+	if (node->leaf_count != 1)
+	{
+		jep_emit(c, OP_NONE, 0, 0, node);
+		return;
+	}
+
+	jep_compile_node(c, &(node->leaves[0]));
+	jep_emit(c, op, a, 0, node);
+}
+
+/* compiles a short circuiting logical operation */
+static void jep_compile_logical(jep_compiler *c, jep_ast_node *node, int left, int op)
+{
+	int jump;
+
+	if (node->leaf_count != 2)
+	{
+		jep_emit(c, OP_NONE, 0, 0, node);
+		return;
+	}
+
+	jep_compile_node(c, &(node->leaves[0]));
+	jump = jep_emit(c, left, -1, 0, node);
+	jep_compile_node(c, &(node->leaves[1]));
+	jep_emit(c, op, 0, 0, node);
+
+	c->chunk->code[jump].a = c->chunk->size;
+}
+
+/* compiles a keyword */
+static int jep_compile_keyword(jep_compiler *c, jep_ast_node *node)
+{
+	switch (node->token.token_code)
+	{
+	case T_RETURN:
+		if (node->leaf_count == 1)
+		{
+			jep_compile_node(c, &(node->leaves[0]));
+			if (node->loop & JEP_TAIL
+				&& c->chunk->code[c->chunk->size - 1].op == OP_CALL)
+			{
+				c->chunk->code[c->chunk->size - 1].op = OP_TAIL_CALL;
+			}
+			jep_emit(c, OP_RETURN, 1, 0, node);
+		}
+		else if (node->leaf_count == 0)
+		{
+			jep_emit(c, OP_RETURN, 0, 0, node);
+			c->sp++;
+		}
+		else
+		{
+			jep_emit(c, OP_NONE, 0, 0, node);
+		}
+		return 1;
+
+	case T_IF:
+		jep_compile_if(c, node);
+		return 1;
+
+	case T_FOR:
+		jep_compile_for(c, node);
+		return 1;
+
+	case T_WHILE:
+		jep_compile_while(c, node);
+		return 1;
+
+	case T_TRY:
+		jep_compile_try(c, node);
+		return 1;
+
+	case T_THROW:
+		jep_compile_node(c, &(node->leaves[0]));
+		jep_emit(c, OP_THROW, 0, 0, node);
+		return 1;
+
+	case T_NULL:
+		jep_emit(c, OP_NULL, 0, 0, node);
+		return 1;
+
+	case T_SWITCH:
+		if (node->cases != NULL)
+		{
+			jep_compile_switch(c, node);
+		}
+		else
+		{
+			/* labels that aren't literals are left to the tree walker */
+			jep_emit(c, OP_EVAL, 0, 0, node);
+		}
+		return 1;
+
+	case T_FUNCTION:
+	case T_STRUCT:
+		jep_emit(c, OP_EVAL, 0, 0, node);
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+/* compiles an AST node, leaving its value on the stack */
+static void jep_compile_node(jep_compiler *c, jep_ast_node *node)
+{
+	switch (node->token.type)
+	{
+	case T_NUMBER:
+		jep_emit(c, OP_NUMBER, 0, 0, node);
+		return;
+
+	case T_CHARACTER:
+		jep_emit(c, OP_CHARACTER, 0, 0, node);
+		return;
+
+	case T_STRING:
+		jep_emit(c, OP_STRING, 0, 0, node);
+		return;
+
+	case T_IDENTIFIER:
+		jep_emit(c, OP_LOAD, 0, 0, node);
+		return;
+
+	case T_KEYWORD:
+		if (jep_compile_keyword(c, node))
+		{
+			return;
+		}
+		break;
+
+	case T_MODIFIER:
+		jep_emit(c, OP_EVAL, 0, 0, node);
+		return;
+
+	default:
+		break;
+	}
+
+	switch (node->token.token_code)
+	{
+	case T_PLUS:          jep_compile_binary(c, node, OP_ADD);      break;
+	case T_STAR:          jep_compile_binary(c, node, OP_MUL);      break;
+	case T_FSLASH:        jep_compile_binary(c, node, OP_DIV);      break;
+	case T_MODULUS:       jep_compile_binary(c, node, OP_MOD);      break;
+	case T_LESS:          jep_compile_binary(c, node, OP_LESS);     break;
+	case T_GREATER:       jep_compile_binary(c, node, OP_GREATER);  break;
+	case T_LOREQUAL:      jep_compile_binary(c, node, OP_LOREQUAL); break;
+	case T_GOREQUAL:      jep_compile_binary(c, node, OP_GOREQUAL); break;
+	case T_EQUIVALENT:    jep_compile_binary(c, node, OP_EQUIV);    break;
+	case T_NOTEQUIVALENT: jep_compile_binary(c, node, OP_NOTEQ);    break;
+	case T_BITAND:        jep_compile_binary(c, node, OP_BITAND);   break;
+	case T_BITOR:         jep_compile_binary(c, node, OP_BITOR);    break;
+	case T_BITXOR:        jep_compile_binary(c, node, OP_BITXOR);   break;
+	case T_LSHIFT:        jep_compile_binary(c, node, OP_LSHIFT);   break;
+	case T_RSHIFT:        jep_compile_binary(c, node, OP_RSHIFT);   break;
+	case T_NOT:           jep_compile_unary(c, node, OP_NOT, 0);    break;
+	case T_LOGAND:        jep_compile_logical(c, node, OP_AND_LEFT, OP_AND); break;
+	case T_LOGOR:         jep_compile_logical(c, node, OP_OR_LEFT, OP_OR);   break;
+
+	case T_MINUS:
+		if (node->leaf_count == 1)
+		{
+			jep_compile_unary(c, node, OP_NEG, 0);
+		}
+		else
+		{
+			jep_compile_binary(c, node, OP_SUB);
+		}
+		break;
+
+	case T_INCREMENT:
+		jep_compile_unary(c, node, OP_INC, node->token.postfix);
+		break;
+
+	case T_DECREMENT:
+		jep_compile_unary(c, node, OP_DEC, node->token.postfix);
+		break;
+
+	case T_LPAREN:
+		jep_compile_paren(c, node);
+		break;
+
+	case T_LBRACE:
+		if (node->array)
+		{
+			jep_emit(c, OP_EVAL, 0, 0, node);
+		}
+		else
+		{
+			jep_compile_block(c, node);
+		}
+		break;
+
+	case T_LSQUARE:
+		if (node->leaf_count == 1)
+		{
+			jep_compile_node(c, &(node->leaves[0]));
+			jep_emit(c, OP_ARRAY, 0, 0, node);
+		}
+		else if (node->leaf_count == 2)
+		{
+			jep_compile_binary(c, node, OP_SUBSCRIPT);
+		}
+		else
+		{
+			jep_emit(c, OP_EVAL, 0, 0, node);
+		}
+		break;
+
+	case T_PERIOD:
+		if (node->leaf_count != 2)
+		{
+			jep_emit(c, OP_EVAL, 0, 0, node);
+			break;
+		}
+		jep_compile_node(c, &(node->leaves[0]));
+		jep_emit(c, OP_MEMBER, 0, 0, node);
+		break;
+
+	case T_EQUALS:
+		if (node->leaf_count != 2)
+		{
+			jep_emit(c, OP_NONE, 0, 0, node);
+			break;
+		}
+		if (node->leaves[0].token.type == T_IDENTIFIER)
+		{
+			/* a variable is found by the assignment, so it isn't copied */
+			jep_compile_node(c, &(node->leaves[1]));
+			jep_emit(c, OP_STORE, 0, 0, &(node->leaves[0]));
+			break;
+		}
+		jep_compile_node(c, &(node->leaves[0]));
+		jep_compile_node(c, &(node->leaves[1]));
+		jep_emit(c, OP_ASSIGN, 0, 0, &(node->leaves[0]));
+		break;
+
+	case T_COMMA:
+		if (node->leaf_count != 2)
+		{
+			jep_emit(c, OP_EVAL, 0, 0, node);
+			break;
+		}
+		jep_compile_node(c, &(node->leaves[0]));
+		jep_emit(c, OP_DROP, 0, 0, node);
+		jep_compile_node(c, &(node->leaves[1]));
+		break;
+
+	case T_ADDASSIGN:
+		/* the target is evaluated once, so strings can be appended in place */
+		jep_compile_node(c, &(node->leaves[0]));
+		jep_compile_node(c, &(node->leaves[1]));
+		jep_emit(c, OP_ADD_ASSIGN, 0, 0, &(node->leaves[0]));
+		break;
+
+	case T_SUBASSIGN:    jep_compile_compound(c, node, OP_SUB);    break;
+	case T_MULASSIGN:    jep_compile_compound(c, node, OP_MUL);    break;
+	case T_DIVASSIGN:    jep_compile_compound(c, node, OP_DIV);    break;
+	case T_MODASSIGN:    jep_compile_compound(c, node, OP_MOD);    break;
+	case T_ANDASSIGN:    jep_compile_compound(c, node, OP_BITAND); break;
+	case T_ORASSIGN:     jep_compile_compound(c, node, OP_BITOR);  break;
+	case T_XORASSIGN:    jep_compile_compound(c, node, OP_BITXOR); break;
+	case T_LSHIFTASSIGN: jep_compile_compound(c, node, OP_LSHIFT); break;
+	case T_RSHIFTASSIGN: jep_compile_compound(c, node, OP_RSHIFT); break;
+
+	default:
+		/* everything else is left to the tree walker */
+		jep_emit(c, OP_EVAL, 0, 0, node);
+		break;
+	}
+}
+
+/* compiles the body of every function definition in an AST */
+static void jep_compile_functions(jep_compiler *c, jep_ast_node *node)
+{
+	int i;
+
+	if (node->token.type == T_KEYWORD && node->token.token_code == T_FUNCTION
+		&& node->leaf_count == 3 && node->leaves[2].code == NULL)
+	{
+		jep_compiler body;
+		body.chunk = jep_create_chunk(node->leaves[0].token.val->buffer);
+		body.last = NULL;
+		body.sp = 0;
+		body.depth = 0;
+
+		jep_compile_node(&body, &(node->leaves[2]));
+		jep_emit(&body, OP_END, 0, 0, node);
+
+		node->leaves[2].code = body.chunk;
+
+		c->last->next = body.chunk;
+		c->last = body.chunk;
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_compile_functions(c, &(node->leaves[i]));
+	}
+}
+
+/* compiles an AST into bytecode */
+jep_chunk *jep_compile(jep_ast_node *root)
+{
+	jep_compiler c;
+	int i;
+
+	c.chunk = jep_create_chunk("main");
+	c.last = c.chunk;
+	c.sp = 0;
+	c.depth = 0;
+
+	for (i = 0; i < root->leaf_count; i++)
+	{
+		jep_compile_node(&c, &(root->leaves[i]));
+		jep_emit(&c, OP_POP_TOP, 0, 0, &(root->leaves[i]));
+	}
+
+	jep_emit(&c, OP_NONE, 0, 0, root);
+	jep_emit(&c, OP_END, 0, 0, root);
+
+	jep_compile_functions(&c, root);
+
+	return c.chunk;
+}
+
+/* prints the instructions of compiled bytecode */
+void jep_print_chunk(jep_chunk *chunk)
+{
+	while (chunk != NULL)
+	{
+		int i;
+		printf("%s:\n", chunk->name);
+		for (i = 0; i < chunk->size; i++)
+		{
+			jep_instr *ins = &(chunk->code[i]);
+			printf("%5d  %-10s %5d %5d", i, op_names[ins->op], ins->a, ins->b);
+			if (ins->node != NULL && ins->node->token.val != NULL)
+			{
+				printf("  %s", ins->node->token.val->buffer);
+			}
+			printf("\n");
+		}
+		chunk = chunk->next;
+	}
+}
+
+/* frees the memory used by compiled bytecode */
+void jep_destroy_chunk(jep_chunk *chunk)
+{
+	while (chunk != NULL)
+	{
+		jep_chunk *next = chunk->next;
+		free(chunk->code);
+		free(chunk);
+		chunk = next;
+	}
+}
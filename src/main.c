@@ -18,6 +18,9 @@
 #include "swap/ast.h"
 #include "swap/parser.h"
 #include "swap/operator.h"
+#include "swap/vm.h"
+#include "swap/resolver.h"
+#include "swap/optimizer.h"
 
 /* command line flag indices */
 #define JEP_TOK 0
@@ -25,16 +28,24 @@
 #define JEP_OBJ 2
 #define JEP_VER 3
 #define JEP_VER_LONG 4
+#define JEP_BYTECODE 5
+#define JEP_WALK 6
+#define JEP_MEM 7
+#define JEP_OPT 8
 
-#define MAX_FLAGS 5
+#define MAX_FLAGS 9
 
 const char *flags[MAX_FLAGS] =
 {
-	"-t",		/* print tokens  */
-	"-a",		/* print ast     */
-	"-o",		/* print objects */
-	"-v",		/* version info  */
-	"--version" /* version info  */
+	"-t",		 /* print tokens                 */
+	"-a",		 /* print ast                    */
+	"-o",		 /* print objects                */
+	"-v",		 /* version info                 */
+	"--version", /* version info                 */
+	"-b",		 /* print bytecode               */
+	"-w",		 /* interpret with the tree walker */
+	"-m",		 /* print allocation statistics  */
+	"-O"		 /* optimize the ast             */
 };
 
 /**
@@ -58,13 +69,30 @@ int main(int argc, char **argv)
 	jep_token_stream *ts = NULL;
 	jep_ast_node *nodes = NULL;
 	jep_ast_node *root = NULL;
-	int flags[MAX_FLAGS] = { 0, 0, 0, 0, 0 };
+	int flags[MAX_FLAGS] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	jep_chunk *chunk = NULL;
+	jep_obj *constants = NULL;
 	int i;
+	int max_depth = 0;
 	char *file_name = NULL;
 
 	for (i = 1; i < argc; i++)
 	{
-		int f = jep_check_flag(argv[i]);
+		int f;
+
+		/* -d takes the maximum depth of function calls as its argument */
+		if (!strcmp(argv[i], "-d"))
+		{
+			if (i + 1 >= argc || (max_depth = atoi(argv[i + 1])) <= 0)
+			{
+				printf("invalid call depth for -d\n");
+				return 1;
+			}
+			i++;
+			continue;
+		}
+
+		f = jep_check_flag(argv[i]);
 		if (f == -1 && file_name == NULL)
 		{
 			file_name = argv[i];
@@ -135,6 +163,16 @@ int main(int argc, char **argv)
 	root->error = 0;
 	root->array = 0;
 	root->loop = 0;
+	root->mod = 0;
+	root->code = NULL;
+	root->slot = -1;
+	root->slots = 0;
+	root->target = 0;
+	root->value = NULL;
+	root->shape = NULL;
+	root->member = -1;
+	root->quick = 0;
+	root->cases = NULL;
 	jep_append_string(root->token.val, "root");
 
 	/* build the AST */
@@ -142,37 +180,73 @@ int main(int argc, char **argv)
 
 	if (root != NULL)
 	{
+		/* convert the literals into the values of the constant pool */
+		if (!root->error)
+		{
+			constants = jep_create_constants(root);
+		}
+
+		/* simplify the AST */
+		if (!root->error && flags[JEP_OPT])
+		{
+			jep_optimize(root, ts, constants);
+		}
+
 		if (!root->error && flags[JEP_AST])
 		{
 			jep_print_ast(*root);
 		}
 
-		if (root->leaves != NULL && !root->error && !flags[JEP_AST] && !flags[JEP_TOK])
+		/* bind identifiers to the slots of function frames */
+		if (!root->error)
 		{
-			jep_obj *list = jep_create_object();
-			list->type = JEP_LIST;
+			jep_resolve(root);
+		}
 
-			/* load the main native library */
-			char* app_path = jep_get_app_path();
+		/* compile the AST unless the tree walker was requested */
+		if (!root->error && !flags[JEP_WALK])
+		{
+			chunk = jep_compile(root);
+		}
 
-			size_t a_len = strlen(app_path);
-			size_t l_len = strlen(SWAP_NATIVE_LIB);
+		if (chunk != NULL && flags[JEP_BYTECODE])
+		{
+			jep_print_chunk(chunk);
+		}
 
-			char* lib_path = malloc(a_len + l_len + 1);
-			strcpy(lib_path, app_path);
-			strcat(lib_path, SWAP_NATIVE_LIB);
-			lib_path[a_len + l_len] = '\0';
+		if (root->leaves != NULL && !root->error && !flags[JEP_AST] && !flags[JEP_TOK] && !flags[JEP_BYTECODE])
+		{
+			jep_obj *list = jep_create_object();
+			list->type = JEP_LIST;
+			list->val = jep_create_env();
 
-			jep_lib native_lib = jep_load_lib(lib_path);
+			if (max_depth > 0)
+			{
+				((jep_env *)list->val)->max_depth = max_depth;
+			}
 
-			free(app_path);
-			free(lib_path);
+			/* nested calls measure the C stack they use from here */
+			((jep_env *)list->val)->stack_base = (char *)&list;
+
+#ifdef SWAP_STATIC_NATIVE
+			/*
+			 * the native functions are linked into the executable,
+			 * so the library has no handle but is still listed
+			 */
+			jep_lib native_lib = NULL;
+			jep_obj *l_native = jep_create_object();
+			l_native->type = JEP_LIBRARY;
+			l_native->ident = jep_intern(ts, " SwapNative");
+			jep_add_object(list, l_native);
+#else
+			/* load the main native library */
+			jep_lib native_lib = jep_load_native_lib();
 
 			if (native_lib != NULL)
 			{
 				jep_obj *l_native = jep_create_object();
 				l_native->type = JEP_LIBRARY;
-				l_native->ident = " SwapNative"; /* prevent code from obtaining a reference to this */
+				l_native->ident = jep_intern(ts, " SwapNative"); /* prevent code from obtaining a reference to this */
 				l_native->val = native_lib;
 				jep_add_object(list, l_native);
 			}
@@ -180,69 +254,111 @@ int main(int argc, char **argv)
 			{
 				printf("could not load native shared library\n");
 			}
+#endif
 
 			/* add built in functions */
 			jep_obj *f_byte = jep_create_object();
 			f_byte->type = JEP_FUNCTION;
-			f_byte->ident = "byte";
+			f_byte->ident = jep_intern(ts, "byte");
 			f_byte->size = 1;
+			f_byte->imm.f = jep_get_native(native_lib, f_byte->ident);
 			jep_add_object(list, f_byte);
 
 			jep_obj *f_bytes = jep_create_object();
 			f_bytes->type = JEP_FUNCTION;
-			f_bytes->ident = "bytes";
+			f_bytes->ident = jep_intern(ts, "bytes");
 			f_bytes->size = 1;
+			f_bytes->imm.f = jep_get_native(native_lib, f_bytes->ident);
 			jep_add_object(list, f_bytes);
 
 			jep_obj *f_char = jep_create_object();
 			f_char->type = JEP_FUNCTION;
-			f_char->ident = "char";
+			f_char->ident = jep_intern(ts, "char");
 			f_char->size = 1;
+			f_char->imm.f = jep_get_native(native_lib, f_char->ident);
 			jep_add_object(list, f_char);
 
 			jep_obj *f_int = jep_create_object();
 			f_int->type = JEP_FUNCTION;
-			f_int->ident = "int";
+			f_int->ident = jep_intern(ts, "int");
 			f_int->size = 1;
+			f_int->imm.f = jep_get_native(native_lib, f_int->ident);
 			jep_add_object(list, f_int);
 
 			jep_obj *f_double = jep_create_object();
 			f_double->type = JEP_FUNCTION;
-			f_double->ident = "double";
+			f_double->ident = jep_intern(ts, "double");
 			f_double->size = 1;
+			f_double->imm.f = jep_get_native(native_lib, f_double->ident);
 			jep_add_object(list, f_double);
 
 			jep_obj *f_typeof = jep_create_object();
 			f_typeof->type = JEP_FUNCTION;
-			f_typeof->ident = "typeof";
+			f_typeof->ident = jep_intern(ts, "typeof");
 			f_typeof->size = 1;
+			f_typeof->imm.f = jep_get_native(native_lib, f_typeof->ident);
 			jep_add_object(list, f_typeof);
 
 			jep_obj *f_len = jep_create_object();
 			f_len->type = JEP_FUNCTION;
-			f_len->ident = "len";
+			f_len->ident = jep_intern(ts, "len");
 			f_len->size = 1;
+			f_len->imm.f = jep_get_native(native_lib, f_len->ident);
 			jep_add_object(list, f_len);
 
+			jep_obj *f_buffer = jep_create_object();
+			f_buffer->type = JEP_FUNCTION;
+			f_buffer->ident = jep_intern(ts, "buffer");
+			f_buffer->size = 1;
+			f_buffer->imm.f = jep_get_native(native_lib, f_buffer->ident);
+			jep_add_object(list, f_buffer);
+
+			jep_obj *f_str = jep_create_object();
+			f_str->type = JEP_FUNCTION;
+			f_str->ident = jep_intern(ts, "str");
+			f_str->size = 1;
+			f_str->imm.f = jep_get_native(native_lib, f_str->ident);
+			jep_add_object(list, f_str);
+
+			jep_obj *f_slice = jep_create_object();
+			f_slice->type = JEP_FUNCTION;
+			f_slice->ident = jep_intern(ts, "slice");
+			f_slice->size = 1;
+			f_slice->imm.f = jep_get_native(native_lib, f_slice->ident);
+			jep_add_object(list, f_slice);
+
 			/* initialize sockets */
 			jep_socket_init();
 
-			/* traverse and interpret the AST */
 			jep_obj *o;
 			int i;
 			int exception = 0;
-			for (i = 0; i < root->leaf_count && !exception; i++)
+			if (chunk != NULL)
 			{
-				o = jep_evaluate(root->leaves[i], list);
+				/* execute the compiled bytecode */
+				o = jep_execute(chunk, list);
 				if (o != NULL)
 				{
-					if (o->ret & JEP_EXCEPTION)
+					printf("unhandled exception: %s\n", (char*)(o->val));
+					jep_destroy_object(o);
+				}
+			}
+			else
+			{
+				/* traverse and interpret the AST */
+				for (i = 0; i < root->leaf_count && !exception; i++)
+				{
+					o = jep_evaluate(&(root->leaves[i]), list);
+					if (o != NULL)
 					{
-						printf("unhandled exception: %s\n", (char*)(o->val));
-						exception = 1;
+						if (o->ret & JEP_EXCEPTION)
+						{
+							printf("unhandled exception: %s\n", (char*)(o->val));
+							exception = 1;
+						}
+						jep_destroy_object(o);
+						o = NULL;
 					}
-					jep_destroy_object(o);
-					o = NULL;
 				}
 			}
 
@@ -262,6 +378,7 @@ int main(int argc, char **argv)
 
 				jep_free_lib(native_lib);
 			}
+			jep_free_extensions();
 
 			if (flags[JEP_OBJ])
 			{
@@ -272,6 +389,18 @@ int main(int argc, char **argv)
 			jep_destroy_object(list);
 		}
 
+		/* destroy the bytecode */
+		jep_destroy_chunk(chunk);
+
+		/* destroy the jump tables of switch statements */
+		jep_destroy_cases(root);
+
+		/* destroy the constant pool */
+		if (constants != NULL)
+		{
+			jep_destroy_object(constants);
+		}
+
 		/* destroy the AST */
 		jep_destroy_string_builder(root->token.val);
 		if (root->leaves != NULL)
@@ -300,8 +429,14 @@ int main(int argc, char **argv)
 	/* quit sockets */
 	jep_socket_quit();
 
-	/* for debugging */
-	/* print_call_counts(); */
+	if (flags[JEP_MEM])
+	{
+		jep_print_pool_stats();
+		jep_print_copy_stats();
+	}
+
+	/* free the slabs of the allocator */
+	jep_destroy_pool();
 
 	return 0;
 }
@@ -15,57 +15,112 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
-#include "swap/native.h"
+#include "swap/extension.h"
 
-/* calls a native function */
-jep_obj *jep_call_native(const char *ident, jep_obj *args)
+#ifdef SWAP_STATIC_NATIVE
+/* the library of functions that are not built in */
+static jep_lib extensions = NULL;
+static int extensions_loaded = 0;
+
+/* finds a built in function by identifier */
+static jep_func jep_get_builtin(const char *ident)
 {
-	jep_obj *o = NULL;
+	int low = 0;
+	int high = jep_native_count - 1;
 
-	char *app_path = jep_get_app_path();
-	if (app_path == NULL)
+	while (low <= high)
 	{
-		return NULL;
+		int mid = (low + high) / 2;
+		int cmp = strcmp(ident, jep_natives[mid].ident);
+		if (cmp == 0)
+		{
+			return jep_natives[mid].func;
+		}
+		else if (cmp < 0)
+		{
+			high = mid - 1;
+		}
+		else
+		{
+			low = mid + 1;
+		}
 	}
 
-	size_t a_len = strlen(app_path);
-	size_t l_len = strlen(SWAP_NATIVE_LIB);
-
-	char *lib_path = malloc(a_len + l_len + 1);
-	strcpy(lib_path, app_path);
-	strcat(lib_path, SWAP_NATIVE_LIB);
-	lib_path[a_len + l_len] = '\0';
+	return NULL;
+}
 
-	jep_lib lib = jep_load_lib(lib_path);
-	if (lib != NULL)
+/*
+ * loads the extension library the first time it is needed.
+ * the SWAP_EXTENSION environment variable names the library to load,
+ * otherwise the native library is loaded from beside the executable.
+ */
+static jep_lib jep_load_extensions()
+{
+	if (!extensions_loaded)
 	{
-		size_t ident_len = strlen(ident);
-		char *native_ident = malloc(ident_len + 6);
-		strcpy(native_ident, "jep_");
-		strcat(native_ident, ident);
-		jep_func func = jep_get_func(lib, native_ident);
+		const char *path = getenv("SWAP_EXTENSION");
 
-		if (func != NULL)
+		if (path != NULL && *path != '\0')
 		{
-			o = func(args, NULL);
+			extensions = jep_load_lib(path);
+			if (extensions == NULL)
+			{
+				printf("could not load extension library %s\n", path);
+			}
 		}
 		else
 		{
-			printf("could not load function %s from shared library\n", native_ident);
+			extensions = jep_load_native_lib();
 		}
+		extensions_loaded = 1;
+	}
 
-		free(native_ident);
-		jep_free_lib(lib);
+	return extensions;
+}
+#endif
+
+/* gets the version of the extension interface */
+int jep_api_version()
+{
+	return SWAP_API_VERSION;
+}
+
+/* frees the extension library */
+void jep_free_extensions()
+{
+#ifdef SWAP_STATIC_NATIVE
+	if (extensions != NULL)
+	{
+		jep_free_lib(extensions);
+		extensions = NULL;
 	}
-	else
+	extensions_loaded = 0;
+#endif
+}
+
+/* loads the native library from the directory of the executable */
+jep_lib jep_load_native_lib()
+{
+	char *app_path = jep_get_app_path();
+	if (app_path == NULL)
 	{
-		printf("could not load shared library\n");
+		return NULL;
 	}
 
+	size_t a_len = strlen(app_path);
+	size_t l_len = strlen(SWAP_NATIVE_LIB);
+
+	char *lib_path = malloc(a_len + l_len + 1);
+	strcpy(lib_path, app_path);
+	strcat(lib_path, SWAP_NATIVE_LIB);
+	lib_path[a_len + l_len] = '\0';
+
+	jep_lib lib = jep_load_lib(lib_path);
+
 	free(app_path);
 	free(lib_path);
 
-	return o;
+	return lib;
 }
 
 /**
@@ -74,11 +129,7 @@ jep_obj *jep_call_native(const char *ident, jep_obj *args)
 jep_obj *jep_call_shared(jep_lib lib, const char *ident, jep_obj *args, jep_obj *list)
 {
 	jep_obj *o = NULL;
-	size_t ident_len = strlen(ident);
-	char *native_ident = malloc(ident_len + 6);
-	strcpy(native_ident, "jep_");
-	strcat(native_ident, ident);
-	jep_func func = jep_get_func(lib, native_ident);
+	jep_func func = jep_get_native(lib, ident);
 
 	if (func != NULL)
 	{
@@ -86,14 +137,59 @@ jep_obj *jep_call_shared(jep_lib lib, const char *ident, jep_obj *args, jep_obj
 	}
 	else
 	{
-		printf("could not load function %s from shared library\n", native_ident);
+		printf("could not load function jep_%s from shared library\n", ident);
 	}
 
-	free(native_ident);
-
 	return o;
 }
 
+/**
+* gets the implementation of a native function
+*/
+jep_func jep_get_native(jep_lib lib, const char *ident)
+{
+	char buffer[64];
+	char *native_ident = buffer;
+	size_t ident_len = strlen(ident);
+	jep_func func = NULL;
+
+#ifdef SWAP_STATIC_NATIVE
+	func = jep_get_builtin(ident);
+	if (func != NULL)
+	{
+		return func;
+	}
+
+	/* anything else comes from an extension library */
+	if (lib == NULL)
+	{
+		lib = jep_load_extensions();
+	}
+#endif
+
+	if (lib == NULL)
+	{
+		return NULL;
+	}
+
+	/* native functions are prefixed with jep_ */
+	if (ident_len + 5 > sizeof(buffer))
+	{
+		native_ident = malloc(ident_len + 5);
+	}
+	strcpy(native_ident, "jep_");
+	strcat(native_ident, ident);
+
+	func = jep_get_func(lib, native_ident);
+
+	if (native_ident != buffer)
+	{
+		free(native_ident);
+	}
+
+	return func;
+}
+
 /**
 * loads a shared library
 */
@@ -18,17 +18,28 @@
 #include "swap/object.h"
 #include "swap/tokenizer.h"
 
-static int creation = 0;
-static int destruction = 0;
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+/* minimum number of cells in the index of a list */
+#define JEP_CELLS_MIN 8
+
+/* values copied and moved between objects */
+static jep_copy_stats copy_stats;
 
 /* TODO: implement memory error */
 jep_obj memory_error = {
 	NULL,
 	"memory error",
+	{0},
 	JEP_STRING,
+	1,
 	NULL, NULL, NULL, NULL,
 	0,
+	NULL,
 	2,
+	0,
 	-1,
 	0,
 	NULL,
@@ -80,6 +91,10 @@ static void jep_print_array(jep_obj *array)
 			{
 				printf("[file] ");
 			}
+			else if (elem->type == JEP_BUFFER)
+			{
+				printf("[buffer]");
+			}
 			else if (elem->type == JEP_ARGUMENT)
 			{
 				printf("[arg]");
@@ -110,20 +125,167 @@ static void jep_print_array(jep_obj *array)
 	printf(" }");
 }
 
-/* frees the memory used by an array */
-static void jep_free_array(jep_obj *array)
+/* the header of a string that is shared by copies of an object */
+typedef struct SharedString
 {
-	if (array != NULL && array->size > 0)
+	int refs;   /* number of objects using the string       */
+	size_t len; /* number of characters in the string       */
+	size_t cap; /* number of characters that fit in memory  */
+} jep_shared_string;
+
+/* copies a string into memory that can be shared by objects */
+static char *jep_share_string(const char *s)
+{
+	size_t len = strlen(s);
+	jep_shared_string *str = malloc(sizeof(jep_shared_string) + len + 1);
+	char *chars = (char *)(str + 1);
+
+	str->refs = 1;
+	str->len = len;
+	str->cap = len;
+	memcpy(chars, s, len + 1);
+
+	return chars;
+}
+
+/* frees a shared string once it is no longer used by any object */
+static void jep_release_string(char *s)
+{
+	jep_shared_string *str = (jep_shared_string *)s - 1;
+
+	if (--(str->refs) == 0)
 	{
-		jep_obj *elem = array->tail;
-		jep_obj *prev = NULL;
-		while (elem != NULL)
+		free(str);
+	}
+}
+
+/* gets the number of objects using the string of an object */
+int jep_string_refs(jep_obj *o)
+{
+	if (o == NULL || o->type != JEP_STRING || !o->shared)
+	{
+		return 0;
+	}
+
+	return ((jep_shared_string *)(o->val) - 1)->refs;
+}
+
+/* appends characters to the string of an object in place */
+void jep_append_chars(jep_obj *o, const char *s)
+{
+	jep_shared_string *str = (jep_shared_string *)(o->val) - 1;
+	size_t n = strlen(s);
+	size_t len = str->len + n;
+
+	/* double the capacity, so that repeated appends are amortized */
+	if (len > str->cap)
+	{
+		size_t cap = str->cap * 2;
+		if (cap < len)
+		{
+			cap = len;
+		}
+		str = realloc(str, sizeof(jep_shared_string) + cap + 1);
+		str->cap = cap;
+		o->val = str + 1;
+	}
+
+	memcpy((char *)(str + 1) + str->len, s, n + 1);
+	str->len = len;
+}
+
+/* gives an object a shared string with room for a number of characters */
+char *jep_string_buffer(jep_obj *o, size_t len)
+{
+	jep_shared_string *str = malloc(sizeof(jep_shared_string) + len + 1);
+	char *chars = (char *)(str + 1);
+
+	str->refs = 1;
+	str->len = len;
+	str->cap = len;
+	chars[len] = '\0';
+
+	o->type = JEP_STRING;
+	o->val = chars;
+	o->shared = 1;
+
+	return chars;
+}
+
+/* allocates a buffer with room for a number of bytes */
+static jep_buf *jep_alloc_buffer(int size)
+{
+	jep_buf *buf = malloc(sizeof(jep_buf) + size);
+
+	buf->refs = 1;
+	buf->size = size;
+
+	return buf;
+}
+
+/* frees a buffer once it is no longer used by any object */
+static void jep_release_buffer(jep_buf *buf)
+{
+	if (--(buf->refs) == 0)
+	{
+		free(buf);
+	}
+}
+
+/* releases the arguments and body shared by copies of a function */
+static void jep_release_function(jep_obj *func)
+{
+	jep_obj *args = func->head;
+
+	func->head = NULL;
+	func->tail = NULL;
+
+	if (args == NULL)
+	{
+		return;
+	}
+
+	if (args->refs > 1)
+	{
+		args->refs--;
+		return;
+	}
+
+	/* destroy the body of non-native functions */
+	if (func->size == 2)
+	{
+		jep_destroy_object(args->next);
+	}
+
+	jep_destroy_object(args);
+}
+
+/* copies the objects in the list of an array or struct */
+static jep_obj *jep_copy_list(jep_obj *src, int deep)
+{
+	jep_obj *list = jep_create_object();
+	jep_obj *orig = src->head; /* original */
+
+	list->type = JEP_LIST;
+	while (orig != NULL)
+	{
+		jep_obj *copy = jep_create_object();
+		copy->ident = orig->ident;
+		copy->index = orig->index;
+		copy->array_ident = orig->array_ident;
+		if (deep)
 		{
-			prev = elem->prev;
-			jep_destroy_object(elem);
-			elem = prev;
+			jep_clone_object(copy, orig);
 		}
+		else
+		{
+			jep_copy_object(copy, orig);
+		}
+		jep_add_object(list, copy);
+		orig = orig->next;
 	}
+
+	return list;
 }
 
 /* creates a string representation of an object */
@@ -274,6 +436,11 @@ char *jep_to_string(jep_obj *o)
 		str = malloc(9);
 		strcpy(str, "[thread]");
 	}
+	else if (o->type == JEP_BUFFER)
+	{
+		str = malloc(9);
+		strcpy(str, "[buffer]");
+	}
 
 	return str;
 }
@@ -281,54 +448,74 @@ char *jep_to_string(jep_obj *o)
 /* converts a character or string of characters into bytes */
 jep_obj *jep_get_bytes(jep_obj *o)
 {
-	jep_obj *bytes = NULL;
-	jep_obj *byte_array = NULL;
 	if (o == NULL || o->val == NULL)
 	{
 		return NULL;
 	}
 
-	if (o->type != JEP_CHARACTER && o->type != JEP_STRING)
+	if (o->type == JEP_CHARACTER)
 	{
-		/* only converting strings and chars for now */
-		return NULL;
+		return jep_create_buffer((unsigned char *)(o->val), 1);
+	}
+	else if (o->type == JEP_STRING)
+	{
+		char *str = (char *)(o->val);
+		return jep_create_buffer((unsigned char *)str, strlen(str));
 	}
 
-	byte_array = jep_create_object();
-	byte_array->type = JEP_ARRAY;
+	/* only converting strings and chars for now */
+	return NULL;
+}
 
-	bytes = jep_create_object();
-	bytes->type = JEP_LIST;
+/* creates a buffer object holding a copy of some bytes */
+jep_obj *jep_create_buffer(const unsigned char *bytes, int size)
+{
+	jep_buf *buf = jep_alloc_buffer(size);
+	jep_obj *o = jep_create_object();
 
-	if (o->type == JEP_CHARACTER)
+	if (bytes != NULL)
 	{
-		jep_obj *byte = jep_create_object();
-		byte->type = JEP_BYTE;
-		unsigned char *c = malloc(1);
-		*c = *((unsigned char *)(o->val));
-		byte->val = c;
-		jep_add_object(bytes, byte);
+		memcpy(buf + 1, bytes, size);
 	}
-	else if (o->type == JEP_STRING)
+	else
 	{
-		char *str = (char *)(o->val);
-		size_t len = strlen(str);
-		unsigned int i;
-		for (i = 0; i < len; i++)
-		{
-			jep_obj *byte = jep_create_object();
-			byte->type = JEP_BYTE;
-			unsigned char *c = malloc(1);
-			*c = str[i];
-			byte->val = c;
-			jep_add_object(bytes, byte);
-		}
+		memset(buf + 1, 0, size);
 	}
 
-	byte_array->val = bytes;
-	byte_array->size = bytes->size;
+	o->type = JEP_BUFFER;
+	o->val = buf;
 
-	return byte_array;
+	return o;
+}
+
+/* gets the bytes of a buffer object */
+unsigned char *jep_buffer_bytes(jep_obj *o)
+{
+	return (unsigned char *)((jep_buf *)(o->val) + 1);
+}
+
+/* gets the number of bytes in a buffer object */
+int jep_buffer_size(jep_obj *o)
+{
+	return ((jep_buf *)(o->val))->size;
+}
+
+/* changes a byte of a buffer object */
+void jep_set_buffer_byte(jep_obj *o, int index, unsigned char b)
+{
+	jep_buf *buf = (jep_buf *)(o->val);
+
+	/* copies of the buffer keep the original bytes */
+	if (buf->refs > 1)
+	{
+		jep_buf *own = jep_alloc_buffer(buf->size);
+		memcpy(own + 1, buf + 1, buf->size);
+		jep_release_buffer(buf);
+		o->val = own;
+		buf = own;
+	}
+
+	((unsigned char *)(buf + 1))[index] = b;
 }
 
 /* compares the values of two objects */
@@ -444,6 +631,17 @@ int jep_compare_object(jep_obj *a, jep_obj *b)
 	}
 	break;
 
+	case JEP_BUFFER:
+	{
+		int size = jep_buffer_size(a);
+		if (size == jep_buffer_size(b)
+			&& !memcmp(jep_buffer_bytes(a), jep_buffer_bytes(b), size))
+		{
+			equal = 1;
+		}
+	}
+	break;
+
 	case JEP_REFERENCE:
 	{
 		jep_obj* a_ref = (jep_obj*)a->val;
@@ -469,39 +667,144 @@ int jep_compare_object(jep_obj *a, jep_obj *b)
 /* allocates memory for a new object */
 jep_obj *jep_create_object()
 {
-	creation++;
-	jep_obj *o = malloc(sizeof(jep_obj));
+	jep_obj *o = jep_pool_alloc(sizeof(jep_obj));
 
 	o->val = NULL;
+	o->imm.d = 0;
 	o->ident = NULL;
 	o->type = 0;
+	o->refs = 1;
 	o->prev = NULL;
 	o->next = NULL;
 	o->head = NULL;
 	o->tail = NULL;
 	o->size = 0;
+	o->cells = NULL;
 	o->ret = 0;
+	o->shared = 0;
 	o->index = -1;
 	o->mod = 0;
 	o->array_ident = NULL;
 	o->self = o;
+	o->shape = NULL;
 
 	return o;
 }
 
-/* adds an object to a list */
+/* stores an int inside of an object */
+void jep_set_int(jep_obj *o, int n)
+{
+	o->imm.i = n;
+	o->val = &(o->imm);
+}
+
+/* stores a long inside of an object */
+void jep_set_long(jep_obj *o, long n)
+{
+	o->imm.l = n;
+	o->val = &(o->imm);
+}
+
+/* stores a double inside of an object */
+void jep_set_double(jep_obj *o, double n)
+{
+	o->imm.d = n;
+	o->val = &(o->imm);
+}
+
+/* stores a byte inside of an object */
+void jep_set_byte(jep_obj *o, unsigned char n)
+{
+	o->imm.b = n;
+	o->val = &(o->imm);
+}
+
+/* stores a character inside of an object */
+void jep_set_char(jep_obj *o, char n)
+{
+	o->imm.c = n;
+	o->val = &(o->imm);
+}
+
+/* gets the number of cells allocated for the index of a list */
+static int jep_cells_cap(int size)
+{
+	int cap = JEP_CELLS_MIN;
+
+	while (cap < size)
+	{
+		cap <<= 1;
+	}
+
+	return cap;
+}
+
+/* adds an object to the end of the index of a list */
+static void jep_append_cell(jep_obj *list, jep_obj *o)
+{
+	int n = list->size - 1; /* number of cells in use */
+
+	/* double the capacity when it has been filled */
+	if (n == jep_cells_cap(n))
+	{
+		list->cells = realloc(list->cells, 2 * n * sizeof(jep_obj *));
+	}
+
+	list->cells[n] = o;
+}
+
+/* frees the index of a list after it has been changed */
+static void jep_free_cells(jep_obj *list)
+{
+	if (list->cells != NULL)
+	{
+		free(list->cells);
+		list->cells = NULL;
+	}
+}
+
+/* gets the object at an index of a list */
+jep_obj *jep_get_element(jep_obj *list, int index)
+{
+	if (list == NULL || index < 0 || index >= list->size)
+	{
+		return NULL;
+	}
+
+	/* index the list the first time one of its elements is accessed */
+	if (list->cells == NULL)
+	{
+		jep_obj *o = list->head;
+		int i = 0;
+
+		list->cells = malloc(jep_cells_cap(list->size) * sizeof(jep_obj *));
+		while (o != NULL && i < list->size)
+		{
+			list->cells[i++] = o;
+			o = o->next;
+		}
+	}
+
+	return list->cells[index];
+}
+
+/*
+ * adds an object to a list.
+ * an object goes into the innermost scope at the tail of the list.
+ */
 void jep_add_object(jep_obj *list, jep_obj *o)
 {
+	while (list->tail != NULL && list->tail->type == JEP_LIST)
+	{
+		list = list->tail;
+	}
+
 	if (list->head == NULL && list->tail == NULL)
 	{
 		list->head = o;
 		list->tail = o;
 		list->size++;
 	}
-	else if (list->tail->type == JEP_LIST)
-	{
-		jep_add_object(list->tail, o);
-	}
 	else
 	{
 		list->tail->next = o;
@@ -509,11 +812,26 @@ void jep_add_object(jep_obj *list, jep_obj *o)
 		list->tail = o;
 		list->size++;
 	}
+
+	if (list->cells != NULL)
+	{
+		jep_append_cell(list, o);
+	}
+
+	/* index the objects at the top level of the main list */
+	if (list->type == JEP_LIST && list->val != NULL && o->ident != NULL)
+	{
+		jep_table_put(((jep_env *)(list->val))->globals, o->ident, o);
+	}
 }
 
 /* removes the last object from a list */
 void jep_pop_object(jep_obj *list)
 {
+	jep_obj *popped = list->tail;
+
+	jep_free_cells(list);
+
 	if (list->size == 1)
 	{
 		list->head = NULL;
@@ -526,6 +844,18 @@ void jep_pop_object(jep_obj *list)
 	}
 
 	list->size--;
+
+	/* an earlier object with the same identifier becomes visible again */
+	if (list->type == JEP_LIST && list->val != NULL
+		&& popped != NULL && popped->ident != NULL)
+	{
+		jep_obj *prev = list->tail;
+		while (prev != NULL && prev->ident != popped->ident)
+		{
+			prev = prev->prev;
+		}
+		jep_table_put(((jep_env *)(list->val))->globals, popped->ident, prev);
+	}
 }
 
 /* retreives an object from a list */
@@ -536,40 +866,152 @@ jep_obj *jep_get_object(const char *ident, jep_obj *list)
 		return NULL;
 	}
 
-	jep_obj *o = NULL;
-	jep_obj *obj = list->head;
-
-	while (obj != NULL)
+	if (list->type == JEP_LIST && list->val != NULL)
 	{
-		if (obj->ident != NULL && !strcmp(ident, obj->ident))
+		/* objects in nested scopes take precedence over globals */
+		if (list->tail != NULL && list->tail->type == JEP_LIST)
 		{
-			o = obj;
+			jep_obj *local = jep_get_object(ident, list->tail);
+			if (local != NULL)
+			{
+				return local;
+			}
 		}
-		if (obj->type == JEP_LIST)
+
+		return jep_get_global(ident, list);
+	}
+
+	jep_obj *o = NULL;
+
+	/*
+	 * a scope nested at the tail of a list is searched after the list,
+	 * so a later match in it takes precedence. the nested scopes of
+	 * every call in progress are followed in a loop instead of
+	 * recursively, so a deep call doesn't need more of the C stack.
+	 */
+	while (list != NULL)
+	{
+		jep_obj *obj = list->head;
+		jep_obj *inner = NULL;
+
+		while (obj != NULL)
 		{
-			jep_obj *temp = NULL;
-			if (o != NULL)
+			if (obj->ident == ident)
 			{
-				temp = o;
+				o = obj;
 			}
-			o = jep_get_object(ident, obj);
-			if (o == NULL && temp != NULL)
+			if (obj->type == JEP_LIST && obj == list->tail)
 			{
-				o = temp;
+				inner = obj;
+			}
+			else if (obj->type == JEP_LIST)
+			{
+				jep_obj *nested = jep_get_object(ident, obj);
+				if (nested != NULL)
+				{
+					o = nested;
+				}
 			}
+			obj = obj->next;
 		}
-		obj = obj->next;
+		list = inner;
 	}
 
 	return o;
 }
 
-/* copies the value of one obect into another */
-void jep_copy_object(jep_obj *dest, jep_obj *src)
+/* retreives an object from the top level of the main list */
+jep_obj *jep_get_global(const char *ident, jep_obj *list)
 {
-	if (dest == NULL || src == NULL)
+	jep_env *env = (jep_env *)(list->val);
+
+	if (env == NULL)
 	{
-		return;
+		return jep_get_object(ident, list);
+	}
+
+	return (jep_obj *)jep_table_get(env->globals, ident);
+}
+
+/*
+ * gets the size of the C stack that nested calls may use, which is
+ * the limit of the system less the reserve for the deepest call
+ */
+static size_t jep_stack_size()
+{
+	size_t size = JEP_STACK_DEFAULT;
+
+#if defined(_WIN32)
+	/* the default stack of an executable */
+	size = 1024 * 1024;
+#else
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+	{
+		size = (size_t)limit.rlim_cur;
+	}
+#endif
+
+	return size > 2 * JEP_STACK_RESERVE ? size - JEP_STACK_RESERVE : size / 2;
+}
+
+/* allocates memory for the state of the main list */
+jep_env *jep_create_env()
+{
+	jep_env *env = malloc(sizeof(jep_env));
+	env->globals = jep_create_table();
+	env->frame = NULL;
+	env->depth = 0;
+	env->max_depth = JEP_MAX_DEPTH;
+	env->stack_base = NULL;
+	env->stack_size = jep_stack_size();
+	return env;
+}
+
+/* frees the memory used by the state of the main list */
+void jep_destroy_env(jep_env *env)
+{
+	if (env != NULL)
+	{
+		jep_destroy_table(env->globals);
+		free(env);
+	}
+}
+
+/* retreives the object of an identifier */
+jep_obj *jep_lookup(jep_ast_node *node, jep_obj *list)
+{
+	jep_env *env = (jep_env *)(list->val);
+	jep_frame *frame = env != NULL ? env->frame : NULL;
+
+	if (node->slot >= 0 && frame != NULL && node->slot < frame->size
+		&& frame->slots[node->slot] != NULL)
+	{
+		return frame->slots[node->slot];
+	}
+
+	return jep_get_object(node->token.val->buffer, list);
+}
+
+/* binds an object to the slot of a resolved identifier */
+void jep_bind_slot(jep_ast_node *node, jep_obj *list, jep_obj *o)
+{
+	jep_env *env = (jep_env *)(list->val);
+	jep_frame *frame = env != NULL ? env->frame : NULL;
+
+	if (node->slot >= 0 && frame != NULL && node->slot < frame->size)
+	{
+		frame->slots[node->slot] = o;
+	}
+}
+
+/* frees the value of an object before it is given a new one */
+static void jep_release_value(jep_obj *dest)
+{
+	/* functions have no value, only a shared definition */
+	if (dest->type == JEP_FUNCTION)
+	{
+		jep_release_function(dest);
 	}
 
 	if (dest->val != NULL)
@@ -577,22 +1019,8 @@ void jep_copy_object(jep_obj *dest, jep_obj *src)
 		if (dest->type == JEP_ARRAY)
 		{
 			/* frees the memory used by an array */
-			jep_free_array((jep_obj *)(dest->val));
+			jep_destroy_object((jep_obj *)(dest->val));
 			dest->size = 0;
-			free(dest->val);
-		}
-		else if (dest->type == JEP_FUNCTION)
-		{
-			jep_obj *args = dest->head;
-
-			/* destroy the body of non-native functions */
-			if (dest->size == 2)
-			{
-				jep_obj *body = args->next;
-				jep_destroy_object(body);
-			}
-
-			jep_destroy_object(args);
 		}
 		else if (dest->type == JEP_REFERENCE)
 		{
@@ -621,61 +1049,95 @@ void jep_copy_object(jep_obj *dest, jep_obj *src)
 		}
 		else if (dest->type == JEP_STRUCT || dest->type == JEP_STRUCTDEF)
 		{
-			jep_destroy_list((jep_obj *)(dest->val));
-			free(dest->val);
+			jep_destroy_object((jep_obj *)(dest->val));
 		}
 		else if (dest->type == JEP_THREAD)
 		{
 			free(dest->val);
 		}
-		else
+		else if (dest->type == JEP_STRING && dest->shared)
+		{
+			jep_release_string((char *)(dest->val));
+		}
+		else if (dest->type == JEP_BUFFER)
+		{
+			jep_release_buffer((jep_buf *)(dest->val));
+		}
+		else if (dest->val != &(dest->imm))
 		{
 			free(dest->val);
 		}
 	}
+}
+
+/* copies the value of one obect into another */
+void jep_copy_object(jep_obj *dest, jep_obj *src)
+{
+	if (dest == NULL || src == NULL)
+	{
+		return;
+	}
+
+	copy_stats.copies++;
+
+	jep_release_value(dest);
+
+	dest->shared = 0;
 
 	dest->type = src->type;
 	dest->ret = src->ret;
 
 	if (src->type == JEP_BYTE)
 	{
-		unsigned char *b = malloc(sizeof(int));
-		*b = *(unsigned char *)(src->val);
-		dest->val = (void *)b;
+		jep_set_byte(dest, *(unsigned char *)(src->val));
+		copy_stats.bytes += sizeof(unsigned char);
 	}
 	else if (src->type == JEP_INT)
 	{
-		int *i = malloc(sizeof(int));
-		*i = *(int *)(src->val);
-		dest->val = (void *)i;
+		jep_set_int(dest, *(int *)(src->val));
+		copy_stats.bytes += sizeof(int);
 	}
 	else if (src->type == JEP_LONG)
 	{
-		long *l = malloc(sizeof(long));
-		*l = *(long *)(src->val);
-		dest->val = (void *)l;
+		jep_set_long(dest, *(long *)(src->val));
+		copy_stats.bytes += sizeof(long);
 	}
 	else if (src->type == JEP_DOUBLE)
 	{
-		double *d = malloc(sizeof(double));
-		*d = *(double *)(src->val);
-		dest->val = (void *)d;
+		jep_set_double(dest, *(double *)(src->val));
+		copy_stats.bytes += sizeof(double);
 	}
 	else if (src->type == JEP_CHARACTER)
 	{
-		char *c = malloc(sizeof(char));
-		*c = *(char *)(src->val);
-		dest->val = (void *)c;
+		if (src->val != NULL)
+		{
+			jep_set_char(dest, *(char *)(src->val));
+			copy_stats.bytes += sizeof(char);
+		}
+		else
+		{
+			dest->val = NULL;
+		}
 	}
 	else if (src->type == JEP_STRING)
 	{
-		int len = strlen((char *)(src->val));
-		dest->val = malloc(len + 1);
-		strcpy(dest->val, (char *)(src->val));
+		if (src->shared)
+		{
+			((jep_shared_string *)(src->val) - 1)->refs++;
+			dest->val = src->val;
+		}
+		else
+		{
+			dest->val = jep_share_string((char *)(src->val));
+			copy_stats.bytes += strlen((char *)(dest->val)) + 1;
+		}
+		dest->shared = 1;
 	}
 	else if (src->type == JEP_LIST)
 	{
 		dest->size = 0;
+		dest->val = NULL;
+		jep_free_cells(dest);
 		jep_obj* src_val = src->head;
 		while (src_val != NULL)
 		{
@@ -687,61 +1149,37 @@ void jep_copy_object(jep_obj *dest, jep_obj *src)
 	}
 	else if (src->type == JEP_ARRAY)
 	{
+		/* share the elements until one of them is modified */
 		jep_obj *array = (jep_obj *)(src->val);
-		jep_obj *dest_array = jep_create_object();
-		dest_array->type = JEP_LIST;
-		if (array != NULL && array->size > 0)
+		if (array == NULL)
 		{
-			jep_obj *orig = array->head; /* original */
-			while (orig != NULL)
-			{
-				jep_obj *copy = jep_create_object();
-				copy->index = orig->index;
-				copy->array_ident = orig->array_ident;
-				jep_copy_object(copy, orig);
-				jep_add_object(dest_array, copy);
-				orig = orig->next;
-			}
+			array = jep_create_object();
+			array->type = JEP_LIST;
+		}
+		else
+		{
+			array->refs++;
 		}
 		dest->size = src->size;
-		dest->val = dest_array;
+		dest->val = array;
 	}
 	else if (src->type == JEP_FUNCTION)
 	{
-		jep_ast_node *n = jep_create_ast_node();
-		jep_obj *args = jep_create_object();
-		jep_obj *body = NULL;
-
-		jep_obj *src_args = src->head;
-		if (src_args != NULL)
-		{
-			jep_obj *a = src_args->head;
-			while (a != NULL)
-			{
-				jep_obj *arg = jep_create_object();
-				arg->type = JEP_ARGUMENT;
-				arg->ident = a->ident;
-				jep_add_object(args, arg);
-				a = a->next;
-			}
-		}
-
-		if (src->size == 2)
+		/* share the arguments and body of the definition */
+		dest->val = NULL;
+		dest->head = src->head;
+		dest->tail = src->tail;
+		dest->size = src->size;
+		if (src->head != NULL)
 		{
-			body = jep_create_object();
-			body->type = JEP_FUNCTION_BODY;
-			*n = *((jep_ast_node *)(src_args->next->val));
-			body->val = n;
+			src->head->refs++;
 		}
 
-		jep_add_object(dest, args);
-
-		if (src->size == 2)
+		if (src->size != 2)
 		{
-			jep_add_object(dest, body);
+			/* native functions keep their resolved implementation */
+			dest->imm.f = src->imm.f;
 		}
-
-		dest->head->type = JEP_LIST;
 	}
 	else if (src->type == JEP_FILE)
 	{
@@ -755,19 +1193,11 @@ void jep_copy_object(jep_obj *dest, jep_obj *src)
 	}
 	else if (src->type == JEP_STRUCT || src->type == JEP_STRUCTDEF)
 	{
-		jep_obj *members = jep_create_object();
-		members->type = JEP_LIST;
-		jep_obj *src_mem = ((jep_obj *)(src->val))->head;
-		while (src_mem != NULL)
-		{
-			jep_obj *mem = jep_create_object();
-			mem->ident = src_mem->ident;
-			mem->index = src_mem->index;
-			jep_copy_object(mem, src_mem);
-			jep_add_object(members, mem);
-			src_mem = src_mem->next;
-		}
+		/* share the members until one of them is modified */
+		jep_obj *members = (jep_obj *)(src->val);
+		members->refs++;
 		dest->val = members;
+		dest->shape = src->shape;
 	}
 	else if (src->type == JEP_THREAD)
 	{
@@ -792,12 +1222,132 @@ void jep_copy_object(jep_obj *dest, jep_obj *src)
 	{
 		dest->val = src->val;
 	}
+	else if (src->type == JEP_BUFFER)
+	{
+		/* share the bytes until one of them is modified */
+		((jep_buf *)(src->val))->refs++;
+		dest->val = src->val;
+	}
 	else if (src->type == JEP_NULL)
 	{
 		dest->val = NULL;
 	}
 }
 
+/* copies the value of one object into another without sharing lists */
+void jep_clone_object(jep_obj *dest, jep_obj *src)
+{
+	if (dest == NULL || src == NULL)
+	{
+		return;
+	}
+
+	if ((src->type == JEP_ARRAY || src->type == JEP_STRUCT
+		|| src->type == JEP_STRUCTDEF) && src->val != NULL)
+	{
+		/* copy the list before dest is changed, since it may contain dest */
+		jep_obj *copy = jep_create_object();
+		copy->type = src->type;
+		copy->ret = src->ret;
+		copy->size = src->size;
+		copy->shape = src->shape;
+		copy->val = jep_copy_list((jep_obj *)(src->val), 1);
+		jep_copy_object(dest, copy);
+		jep_destroy_object(copy);
+	}
+	else
+	{
+		jep_copy_object(dest, src);
+	}
+}
+
+/* hands the value of a temporary object over to another object */
+void jep_move_object(jep_obj *dest, jep_obj *src)
+{
+	if (dest == NULL || src == NULL || dest == src)
+	{
+		return;
+	}
+
+	/* a list that is still used by another object has to be copied */
+	if (src->type == JEP_LIST || src->refs > 1)
+	{
+		jep_copy_object(dest, src);
+		return;
+	}
+
+	copy_stats.moves++;
+
+	jep_release_value(dest);
+
+	dest->type = src->type;
+	dest->ret = src->ret;
+	dest->shared = src->shared;
+	dest->shape = src->shape;
+	dest->imm = src->imm;
+	dest->val = src->val == &(src->imm) ? &(dest->imm) : src->val;
+
+	if (src->type == JEP_ARRAY)
+	{
+		dest->size = src->size;
+	}
+	else if (src->type == JEP_FUNCTION)
+	{
+		dest->head = src->head;
+		dest->tail = src->tail;
+		dest->size = src->size;
+		src->head = NULL;
+		src->tail = NULL;
+	}
+
+	/* leave src without a value */
+	src->type = JEP_NULL;
+	src->val = NULL;
+	src->shared = 0;
+}
+
+/* gets the statistics of the values copied and moved between objects */
+jep_copy_stats jep_get_copy_stats()
+{
+	return copy_stats;
+}
+
+/* writes the statistics of copied and moved values to standard out */
+void jep_print_copy_stats()
+{
+	printf("%8s %10s %10s\n", "copies", "moves", "bytes");
+	printf("%8ld %10ld %10ld\n",
+		copy_stats.copies, copy_stats.moves, copy_stats.bytes);
+}
+
+/* gives the owner of a copied array or struct its own list */
+void jep_unshare(jep_obj *o)
+{
+	jep_obj *owner;
+	jep_obj *shared;
+
+	if (o == NULL || (o->type != JEP_ARRAY && o->type != JEP_STRUCT))
+	{
+		return;
+	}
+
+	owner = o->self;
+	shared = (jep_obj *)(o->val);
+
+	/* the list is only used by the owner and this copy of it */
+	if (owner == NULL || owner == o || shared == NULL
+		|| owner->val != o->val || shared->refs <= 2)
+	{
+		return;
+	}
+
+	owner->val = jep_copy_list(shared, 0);
+	shared->refs -= 2;
+
+	o->val = owner->val;
+	((jep_obj *)(o->val))->refs++;
+}
+
 void jep_copy_main_list(jep_obj *dest, jep_obj *src)
 {
 	if (dest == NULL || src == NULL)
@@ -810,22 +1360,12 @@ void jep_copy_main_list(jep_obj *dest, jep_obj *src)
 		if (dest->type == JEP_ARRAY)
 		{
 			/* frees the memory used by an array */
-			jep_free_array((jep_obj *)(dest->val));
+			jep_destroy_object((jep_obj *)(dest->val));
 			dest->size = 0;
-			free(dest->val);
 		}
 		else if (dest->type == JEP_FUNCTION)
 		{
-			jep_obj *args = dest->head;
-
-			/* destroy the body of non-native functions */
-			if (dest->size == 2)
-			{
-				jep_obj *body = args->next;
-				jep_destroy_object(body);
-			}
-
-			jep_destroy_object(args);
+			jep_release_function(dest);
 		}
 		else if (dest->type == JEP_REFERENCE)
 		{
@@ -854,30 +1394,40 @@ void jep_copy_main_list(jep_obj *dest, jep_obj *src)
 		}
 		else if (dest->type == JEP_STRUCT || dest->type == JEP_STRUCTDEF)
 		{
-			jep_destroy_list((jep_obj *)(dest->val));
-			free(dest->val);
+			jep_destroy_object((jep_obj *)(dest->val));
 		}
 		else if (dest->type == JEP_THREAD)
 		{
 			free(dest->val);
 		}
-		else
+		else if (dest->type == JEP_STRING && dest->shared)
+		{
+			jep_release_string((char *)(dest->val));
+		}
+		else if (dest->type == JEP_BUFFER)
+		{
+			jep_release_buffer((jep_buf *)(dest->val));
+		}
+		else if (dest->val != &(dest->imm))
 		{
 			free(dest->val);
 		}
 	}
 
+	dest->shared = 0;
+
 	dest->type = src->type;
 	dest->ret = src->ret;
 
 	if (src->type == JEP_LIST)
 	{
 		dest->size = 0;
+		jep_free_cells(dest);
 		jep_obj* src_val = src->head;
 		while (src_val != NULL)
 		{
 			jep_obj* dest_val = jep_create_object();
-			jep_copy_object(dest_val, src_val);
+			jep_clone_object(dest_val, src_val);
 			dest_val->ident = src_val->ident;
 			jep_add_object(dest, dest_val);
 			src_val = src_val->next;
@@ -904,7 +1454,9 @@ void jep_copy_self(jep_obj *dest, jep_obj *src)
 	{
 		jep_obj *src_array = (jep_obj *)(src->val);
 		jep_obj *dest_array = (jep_obj *)(dest->val);
-		if (src_array != NULL && src_array->size > 0)
+
+		/* the elements of a shared list are already the actual objects */
+		if (src_array != NULL && src_array != dest_array && src_array->size > 0)
 		{
 			jep_obj *src_e = src_array->head;   /* source */
 			jep_obj *dest_e = dest_array->head; /* destination */
@@ -927,11 +1479,20 @@ void jep_copy_self(jep_obj *dest, jep_obj *src)
 /* frees the memory used by an object */
 void jep_destroy_object(jep_obj *obj)
 {
-	destruction++;
-
 	if (obj != NULL)
 	{
-		if (obj->type == JEP_INT && obj->val != NULL)
+		/* lists of arrays and structs may still be used by other copies */
+		if (obj->refs > 1)
+		{
+			obj->refs--;
+			return;
+		}
+
+		if (obj->val == &(obj->imm))
+		{
+			/* scalars stored inside of the object */
+		}
+		else if (obj->type == JEP_INT && obj->val != NULL)
 		{
 			free(obj->val);
 		}
@@ -951,10 +1512,18 @@ void jep_destroy_object(jep_obj *obj)
 		{
 			free(obj->val);
 		}
+		else if (obj->type == JEP_STRING && obj->val != NULL && obj->shared)
+		{
+			jep_release_string((char *)(obj->val));
+		}
 		else if (obj->type == JEP_STRING && obj->val != NULL)
 		{
 			free(obj->val);
 		}
+		else if (obj->type == JEP_BUFFER && obj->val != NULL)
+		{
+			jep_release_buffer((jep_buf *)(obj->val));
+		}
 		else if (obj->type == JEP_ARRAY && obj->val != NULL)
 		{
 			jep_obj *array = (jep_obj *)(obj->val);
@@ -962,19 +1531,7 @@ void jep_destroy_object(jep_obj *obj)
 		}
 		else if (obj->type == JEP_FUNCTION)
 		{
-			jep_obj *args = obj->head;
-
-			/* destroy the body of non-native functions */
-			if (obj->size == 2)
-			{
-				jep_obj *body = args->next;
-				jep_destroy_object(body);
-			}
-
-			if (args != NULL)
-			{
-				jep_destroy_object(args);
-			}
+			jep_release_function(obj);
 		}
 		else if (obj->type == JEP_FUNCTION_BODY)
 		{
@@ -1036,6 +1593,7 @@ void jep_destroy_object(jep_obj *obj)
 		else if (obj->type == JEP_LIST)
 		{
 			jep_destroy_list(obj);
+			jep_destroy_env((jep_env *)(obj->val));
 		}
 		else if (obj->type == JEP_LIBRARY)
 		{
@@ -1052,7 +1610,7 @@ void jep_destroy_object(jep_obj *obj)
 		}
 
 		obj->val = NULL;
-		free(obj);
+		jep_pool_free(obj, sizeof(jep_obj));
 	}
 }
 
@@ -1064,6 +1622,8 @@ void jep_destroy_list(jep_obj *list)
 		return;
 	}
 
+	jep_free_cells(list);
+
 	jep_obj *obj = list->head;
 	jep_obj *next = NULL;
 
@@ -1085,7 +1645,6 @@ jep_obj *jep_number(const char *s)
 	char *endptr;
 	long int l;
 	double d;
-	void *val;
 	jep_obj *obj;
 
 	errno = 0;
@@ -1111,11 +1670,8 @@ jep_obj *jep_number(const char *s)
 			printf("byte out of range\n");
 			return NULL;
 		}
-		unsigned char *b = malloc(1);
-		*b = (unsigned char)(l & UCHAR_MAX);
-		val = (void *)b;
 		obj = jep_create_object();
-		obj->val = (void *)val;
+		jep_set_byte(obj, (unsigned char)(l & UCHAR_MAX));
 		obj->type = JEP_BYTE;
 
 		return obj;
@@ -1147,31 +1703,22 @@ jep_obj *jep_number(const char *s)
 		}
 		else
 		{
-			double *d_ptr = malloc(sizeof(double));
-			*d_ptr = d;
-			val = (void *)d_ptr;
 			obj = jep_create_object();
-			obj->val = (void *)val;
+			jep_set_double(obj, d);
 			obj->type = JEP_DOUBLE;
 		}
 	}
 	else if (l >= INT_MIN && l <= INT_MAX)
 	{
 		/* cast the value as an int if it will fit */
-		int *l_ptr = malloc(sizeof(int));
-		*l_ptr = (int)l;
-		val = (void *)l_ptr;
 		obj = jep_create_object();
-		obj->val = (void *)val;
+		jep_set_int(obj, (int)l);
 		obj->type = JEP_INT;
 	}
 	else
 	{
-		long int *l_ptr = malloc(sizeof(long int));
-		*l_ptr = l;
-		val = (void *)l_ptr;
 		obj = jep_create_object();
-		obj->val = (void *)val;
+		jep_set_long(obj, l);
 		obj->type = JEP_LONG;
 	}
 
@@ -1208,9 +1755,7 @@ jep_obj *jep_character(const char *s)
 	*/
 	else
 	{
-		char *c = malloc(1);
-		*c = s[0];
-		obj->val = (void *)c;
+		jep_set_char(obj, s[0]);
 	}
 
 	return obj;
@@ -1229,6 +1774,48 @@ jep_obj *jep_string(const char *s)
 	return obj;
 }
 
+/* converts a literal into the value that is kept in the constant pool */
+jep_obj *jep_constant(jep_ast_node *node)
+{
+	jep_obj *obj = NULL;
+	const char *s = node->token.val->buffer;
+
+	if (node->token.type == T_NUMBER)
+	{
+		obj = jep_number(s);
+	}
+	else if (node->token.type == T_CHARACTER)
+	{
+		obj = jep_character(s);
+	}
+	else if (node->token.type == T_STRING)
+	{
+		obj = jep_create_object();
+		obj->type = JEP_STRING;
+		obj->val = jep_share_string(s);
+		obj->shared = 1;
+	}
+
+	return obj;
+}
+
+/* gets a copy of the value of a literal from the constant pool */
+jep_obj *jep_literal(jep_ast_node *node)
+{
+	jep_obj *obj;
+
+	/* a literal that isn't in the pool is converted every time */
+	if (node->value == NULL)
+	{
+		return jep_constant(node);
+	}
+
+	obj = jep_create_object();
+	jep_copy_object(obj, node->value);
+
+	return obj;
+}
+
 /* convertes an ast into an array */
 jep_obj *jep_array(jep_ast_node *ast)
 {
@@ -1324,6 +1911,10 @@ void jep_print_object(jep_obj *obj)
 		{
 			printf("[library] %s\n", obj->ident);
 		}
+		else if (obj->type == JEP_BUFFER)
+		{
+			printf("[buffer] %s: %d bytes\n", obj->ident, jep_buffer_size(obj));
+		}
 		else
 		{
 			printf("unrecognized type while printing object %d\n", obj->type);
@@ -1359,6 +1950,20 @@ void jep_print_list(jep_obj *list)
 	} while (obj != NULL);
 }
 
+/* destroys the objects in a scope so it can be used again */
+void jep_clear_scope(jep_obj *scope)
+{
+	if (scope->head == NULL)
+	{
+		return;
+	}
+
+	jep_destroy_list(scope);
+	scope->head = NULL;
+	scope->tail = NULL;
+	scope->size = 0;
+}
+
 /* removes the scope list off the tail of a list */
 void jep_remove_scope(jep_obj *list)
 {
@@ -1375,29 +1980,21 @@ void jep_remove_scope(jep_obj *list)
 		return;
 	}
 
-	jep_obj *tail = list->tail;
+	/* find the list that holds the innermost scope */
+	while (list->tail->tail != NULL && list->tail->tail->type == JEP_LIST)
+	{
+		list = list->tail;
+	}
 
-	if (tail->tail != NULL && tail->tail->type == JEP_LIST)
+	jep_free_cells(list);
+	list->tail = list->tail->prev;
+	if (list->tail != NULL)
 	{
-		jep_remove_scope(tail);
+		list->tail->next = NULL;
 	}
-	else if (list->tail != NULL)
+	list->size--;
+	if (list->size == 0)
 	{
-		list->tail = list->tail->prev;
-		if (list->tail != NULL)
-		{
-			list->tail->next = NULL;
-		}
-		list->size--;
-		if (list->size == 0)
-		{
-			list->head = NULL;
-		}
+		list->head = NULL;
 	}
 }
-
-void print_call_counts()
-{
-	printf("objects created: %d\n", creation);
-	printf("objects destroyed: %d\n", destruction);
-}
@@ -16,434 +16,543 @@
 	along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "swap/operator.h"
+#include "swap/vm.h"
+#include "swap/resolver.h"
+
+/* operations that a binary operator node specializes to */
+#define JEP_QUICK_NONE 0     /* the node has not been evaluated yet      */
+#define JEP_QUICK_INT 1      /* the node has only seen two int operands  */
+#define JEP_QUICK_GENERIC -1 /* the node has seen operands of other types */
+
+static int jep_quickens(int token_code);
+static int jep_thrown(jep_obj **l, jep_obj **r);
 
 /* evaluates the nodes of an AST */
 /* TODO ensure that this doesn't return a NULL pointer */
-jep_obj *jep_evaluate(jep_ast_node ast, jep_obj *list)
+jep_obj *jep_evaluate(jep_ast_node *ast, jep_obj *list)
 {
 	jep_obj *o = NULL;
 
-	if (ast.token.type == T_NUMBER)
-	{
-		return jep_number(ast.token.val->buffer);
-	}
-	else if (ast.token.type == T_CHARACTER)
+	if (ast->quick == JEP_QUICK_INT)
 	{
-		return jep_character(ast.token.val->buffer);
+		return jep_quick_int(ast, list);
 	}
-	else if (ast.token.type == T_STRING)
+
+	if (ast->token.type == T_NUMBER || ast->token.type == T_CHARACTER
+		|| ast->token.type == T_STRING)
 	{
-		return jep_string(ast.token.val->buffer);
+		return jep_literal(ast);
 	}
-	else if (ast.token.type == T_IDENTIFIER)
+	else if (ast->token.type == T_IDENTIFIER)
 	{
-		jep_obj *e = jep_get_object(ast.token.val->buffer, list);
-		if (e != NULL)
-		{
-			o = jep_create_object();
-			jep_copy_object(o, e);
-			jep_copy_self(o, e);
-			o->ident = e->ident;
-		}
-		return o;
+		return jep_identifier(ast, list);
 	}
-	else if (ast.token.type == T_KEYWORD)
+	else if (ast->token.type == T_KEYWORD)
 	{
-		if (ast.token.token_code == T_FUNCTION)
+		if (ast->token.token_code == T_FUNCTION)
 		{
-			return jep_function(ast, list);
+			return jep_function(*ast, list);
 		}
-		else if (ast.token.token_code == T_RETURN)
+		else if (ast->token.token_code == T_RETURN)
 		{
-			return jep_return(ast, list);
+			return jep_return(*ast, list);
 		}
-		else if (ast.token.token_code == T_IF)
+		else if (ast->token.token_code == T_IF)
 		{
-			return jep_if(ast, list);
+			return jep_if(*ast, list);
 		}
-		else if (ast.token.token_code == T_SWITCH)
+		else if (ast->token.token_code == T_SWITCH)
 		{
-			return jep_switch(ast, list);
+			return jep_switch(*ast, list);
 		}
-		else if (ast.token.token_code == T_FOR)
+		else if (ast->token.token_code == T_FOR)
 		{
-			return jep_for(ast, list);
+			return jep_for(*ast, list);
 		}
-		else if (ast.token.token_code == T_WHILE)
+		else if (ast->token.token_code == T_WHILE)
 		{
-			return jep_while(ast, list);
+			return jep_while(*ast, list);
 		}
-		else if (ast.token.token_code == T_TRY)
+		else if (ast->token.token_code == T_TRY)
 		{
-			return jep_try(ast, list);
+			return jep_try(*ast, list);
 		}
-		else if (ast.token.token_code == T_THROW)
+		else if (ast->token.token_code == T_THROW)
 		{
-			return jep_throw(ast, list);
+			return jep_throw(*ast, list);
 		}
-		else if (ast.token.token_code == T_NULL)
+		else if (ast->token.token_code == T_NULL)
 		{
 			jep_obj *n = jep_create_object();
 			n->type = JEP_NULL;
 			return n;
 		}
-		else if (ast.token.token_code == T_STRUCT)
+		else if (ast->token.token_code == T_STRUCT)
 		{
-			return jep_struct(ast, list);
+			return jep_struct(*ast, list);
 		}
 	}
-	else if (ast.token.type == T_MODIFIER)
+	else if (ast->token.type == T_MODIFIER)
+	{
+		return jep_modifier(*ast, list);
+	}
+
+	/* a binary operator sees the types of its operands the first time */
+	if (ast->quick == JEP_QUICK_NONE && ast->leaf_count == 2
+		&& jep_quickens(ast->token.token_code))
 	{
-		return jep_modifier(ast, list);
+		return jep_quick_int(ast, list);
 	}
 
-	switch (ast.token.token_code)
+	switch (ast->token.token_code)
 	{
 	case T_PLUS:
-		o = jep_add(ast, list);
+		o = jep_add(*ast, list);
 		break;
 
 	case T_MINUS:
-		o = jep_sub(ast, list);
+		o = jep_sub(*ast, list);
 		break;
 
 	case T_STAR:
-		o = jep_mul(ast, list);
+		o = jep_mul(*ast, list);
 		break;
 
 	case T_FSLASH:
-		o = jep_div(ast, list);
+		o = jep_div(*ast, list);
 		break;
 
 	case T_MODULUS:
-		o = jep_modulus(ast, list);
+		o = jep_modulus(*ast, list);
 		break;
 
 	case T_LESS:
-		o = jep_less(ast, list);
+		o = jep_less(*ast, list);
 		break;
 
 	case T_GREATER:
-		o = jep_greater(ast, list);
+		o = jep_greater(*ast, list);
 		break;
 
 	case T_LOREQUAL:
-		o = jep_lorequal(ast, list);
+		o = jep_lorequal(*ast, list);
 		break;
 
 	case T_GOREQUAL:
-		o = jep_gorequal(ast, list);
+		o = jep_gorequal(*ast, list);
 		break;
 
 	case T_EQUIVALENT:
-		o = jep_equiv(ast, list);
+		o = jep_equiv(*ast, list);
 		break;
 
 	case T_NOTEQUIVALENT:
-		o = jep_noteq(ast, list);
+		o = jep_noteq(*ast, list);
 		break;
 
 	case T_NOT:
-		o = jep_not(ast, list);
+		o = jep_not(*ast, list);
 		break;
 
 	case T_LOGAND:
-		o = jep_and(ast, list);
+		o = jep_and(*ast, list);
 		break;
 
 	case T_LOGOR:
-		o = jep_or(ast, list);
+		o = jep_or(*ast, list);
 		break;
 
 	case T_BITAND:
-		o = jep_bitand(ast, list);
+		o = jep_bitand(*ast, list);
 		break;
 
 	case T_BITOR:
-		o = jep_bitor(ast, list);
+		o = jep_bitor(*ast, list);
 		break;
 
 	case T_BITXOR:
-		o = jep_bitxor(ast, list);
+		o = jep_bitxor(*ast, list);
 		break;
 
 	case T_LSHIFT:
-		o = jep_lshift(ast, list);
+		o = jep_lshift(*ast, list);
 		break;
 
 	case T_RSHIFT:
-		o = jep_rshift(ast, list);
+		o = jep_rshift(*ast, list);
 		break;
 
 	case T_INCREMENT:
-		o = jep_inc(ast, list);
+		o = jep_inc(*ast, list);
 		break;
 
 	case T_DECREMENT:
-		o = jep_dec(ast, list);
+		o = jep_dec(*ast, list);
 		break;
 
 	case T_LPAREN:
-		o = jep_paren(ast, list);
+		o = jep_paren(*ast, list);
 		break;
 
 	case T_LBRACE:
-		o = jep_brace(ast, list);
+		o = jep_brace(*ast, list);
 		break;
 
 	case T_LSQUARE:
-		o = jep_subscript(ast, list);
+		o = jep_subscript(*ast, list);
 		break;
 
 	case T_EQUALS:
-		o = jep_assign(ast, list);
+		o = jep_assign(*ast, list);
 		break;
 
 	case T_COMMA:
-		o = jep_comma(ast, list);
+		o = jep_comma(*ast, list);
 		break;
 
 	case T_COLON:
-		o = jep_reference(ast, list);
+		o = jep_reference(*ast, list);
 		break;
 
 	case T_DOUBLECOLON:
-		o = jep_dereference(ast, list);
+		o = jep_dereference(*ast, list);
 		break;
 
 	case T_ADDASSIGN:
-		o = jep_add_assign(ast, list);
+		o = jep_add_assign(*ast, list);
 		break;
 
 	case T_SUBASSIGN:
-		o = jep_sub_assign(ast, list);
+		o = jep_sub_assign(*ast, list);
 		break;
 
 	case T_DIVASSIGN:
-		o = jep_div_assign(ast, list);
+		o = jep_div_assign(*ast, list);
 		break;
 
 	case T_MULASSIGN:
-		o = jep_mul_assign(ast, list);
+		o = jep_mul_assign(*ast, list);
 		break;
 
 	case T_MODASSIGN:
-		o = jep_mod_assign(ast, list);
+		o = jep_mod_assign(*ast, list);
 		break;
 
 	case T_ANDASSIGN:
-		o = jep_and_assign(ast, list);
+		o = jep_and_assign(*ast, list);
 		break;
 
 	case T_ORASSIGN:
-		o = jep_or_assign(ast, list);
+		o = jep_or_assign(*ast, list);
 		break;
 
 	case T_XORASSIGN:
-		o = jep_xor_assign(ast, list);
+		o = jep_xor_assign(*ast, list);
 		break;
 
 	case T_LSHIFTASSIGN:
-		o = jep_lshift_assign(ast, list);
+		o = jep_lshift_assign(*ast, list);
 		break;
 
 	case T_RSHIFTASSIGN:
-		o = jep_rshift_assign(ast, list);
+		o = jep_rshift_assign(*ast, list);
 		break;
 
 	case T_NEW:
-		o = jep_new(ast, list);
+		o = jep_new(*ast, list);
 		break;
 
 	case T_PERIOD:
-		o = jep_member(ast, list);
+		o = jep_member(*ast, list);
 		break;
 
 	default:
 		printf("unrecognized token: %s\n",
-			ast.token.val->buffer);
+			ast->token.val->buffer);
 		break;
 	}
 
 	return o;
 }
 
-/* evaluates an addition expression */
-jep_obj *jep_add(jep_ast_node node, jep_obj *list)
+/* evaluates an identifier */
+jep_obj *jep_identifier(jep_ast_node *node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	jep_obj *o = NULL;
+	jep_obj *e = jep_lookup(node, list);
 
-	if (node.leaf_count != 2)
+	if (e != NULL)
 	{
-		return NULL;
+		o = jep_create_object();
+		jep_copy_object(o, e);
+		jep_copy_self(o, e);
+		o->ident = e->ident;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		/* string concatenation */
-		if (l->type == JEP_STRING || r->type == JEP_STRING)
-		{
-			char *l_str = jep_to_string(l);
-			char *r_str = jep_to_string(r);
-
-			if (l_str != NULL && r_str != NULL)
-			{
-				result = jep_create_object();
-				result->type = JEP_STRING;
+	return o;
+}
 
-				char *str = malloc(strlen(l_str) + strlen(r_str) + 1);
-				strcpy(str, l_str);
-				strcat(str, r_str);
-				result->val = (void *)(str);
-			}
+/*
+ * numeric operators are dispatched on the types of both operands.
+ * the numeric types are contiguous from JEP_BYTE to JEP_CHARACTER,
+ * so each operator has a table of kernels indexed by the two types,
+ * and each kernel reads its operands directly as the right C types.
+ */
+#define JEP_NUM_TYPES 5
+#define JEP_NUM_INDEX(t) ((t) - JEP_BYTE)
+#define JEP_IS_NUMERIC(t) ((t) >= JEP_BYTE && (t) <= JEP_CHARACTER)
+
+/* an operation on two numeric objects that sets the value of a result */
+typedef void(*jep_kernel)(jep_obj *result, jep_obj *l, jep_obj *r);
+
+/* the values of numeric objects */
+#define JEP_B(o) (*(unsigned char *)((o)->val))
+#define JEP_I(o) (*(int *)((o)->val))
+#define JEP_L(o) (*(long *)((o)->val))
+#define JEP_D(o) (*(double *)((o)->val))
+#define JEP_C(o) (*(char *)((o)->val))
+
+/* defines a kernel that stores the result of an expression as a type */
+#define JEP_KERNEL(name, lv, op, rv, set, ctype, rtype) \
+static void name(jep_obj *result, jep_obj *l, jep_obj *r) \
+{                                                         \
+	set(result, (ctype)(lv(l) op rv(r)));                 \
+	result->type = rtype;                                 \
+}
 
-			if (l_str != NULL)
-			{
-				free(l_str);
-			}
+/*
+ * arithmetic on bytes, ints, longs, and doubles.
+ * a double operand makes the result a double, otherwise a long
+ * operand makes it a long, and a byte with an int is a byte.
+ */
+#define JEP_ARITHMETIC(name, op)                                                  \
+JEP_KERNEL(name##_bb, JEP_B, op, JEP_B, jep_set_byte, unsigned char, JEP_BYTE)    \
+JEP_KERNEL(name##_bi, JEP_B, op, JEP_I, jep_set_byte, unsigned char, JEP_BYTE)    \
+JEP_KERNEL(name##_bl, JEP_B, op, JEP_L, jep_set_long, long, JEP_LONG)             \
+JEP_KERNEL(name##_bd, JEP_B, op, JEP_D, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_ib, JEP_I, op, JEP_B, jep_set_byte, unsigned char, JEP_BYTE)    \
+JEP_KERNEL(name##_ii, JEP_I, op, JEP_I, jep_set_int, int, JEP_INT)                \
+JEP_KERNEL(name##_il, JEP_I, op, JEP_L, jep_set_long, long, JEP_LONG)             \
+JEP_KERNEL(name##_id, JEP_I, op, JEP_D, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_lb, JEP_L, op, JEP_B, jep_set_long, long, JEP_LONG)             \
+JEP_KERNEL(name##_li, JEP_L, op, JEP_I, jep_set_long, long, JEP_LONG)             \
+JEP_KERNEL(name##_ll, JEP_L, op, JEP_L, jep_set_long, long, JEP_LONG)             \
+JEP_KERNEL(name##_ld, JEP_L, op, JEP_D, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_db, JEP_D, op, JEP_B, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_di, JEP_D, op, JEP_I, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_dl, JEP_D, op, JEP_L, jep_set_double, double, JEP_DOUBLE)       \
+JEP_KERNEL(name##_dd, JEP_D, op, JEP_D, jep_set_double, double, JEP_DOUBLE)       \
+static const jep_kernel name[JEP_NUM_TYPES][JEP_NUM_TYPES] =                      \
+{                                                                                 \
+	{ name##_bb, name##_bi, name##_bl, name##_bd, NULL },                         \
+	{ name##_ib, name##_ii, name##_il, name##_id, NULL },                         \
+	{ name##_lb, name##_li, name##_ll, name##_ld, NULL },                         \
+	{ name##_db, name##_di, name##_dl, name##_dd, NULL },                         \
+	{ NULL, NULL, NULL, NULL, NULL }                                              \
+};
+
+/* comparison of any two numeric values, resulting in an int */
+#define JEP_COMPARISON(name, op)                                 \
+JEP_KERNEL(name##_bb, JEP_B, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bi, JEP_B, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bl, JEP_B, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bd, JEP_B, op, JEP_D, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bc, JEP_B, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ib, JEP_I, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ii, JEP_I, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_il, JEP_I, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_id, JEP_I, op, JEP_D, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ic, JEP_I, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_lb, JEP_L, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_li, JEP_L, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ll, JEP_L, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ld, JEP_L, op, JEP_D, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_lc, JEP_L, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_db, JEP_D, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_di, JEP_D, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_dl, JEP_D, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_dd, JEP_D, op, JEP_D, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_dc, JEP_D, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cb, JEP_C, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ci, JEP_C, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cl, JEP_C, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cd, JEP_C, op, JEP_D, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cc, JEP_C, op, JEP_C, jep_set_int, int, JEP_INT) \
+static const jep_kernel name[JEP_NUM_TYPES][JEP_NUM_TYPES] =       \
+{                                                                  \
+	{ name##_bb, name##_bi, name##_bl, name##_bd, name##_bc },     \
+	{ name##_ib, name##_ii, name##_il, name##_id, name##_ic },     \
+	{ name##_lb, name##_li, name##_ll, name##_ld, name##_lc },     \
+	{ name##_db, name##_di, name##_dl, name##_dd, name##_dc },     \
+	{ name##_cb, name##_ci, name##_cl, name##_cd, name##_cc }      \
+};
+
+/* bitwise operation on integral values, truncated to an int */
+#define JEP_BITWISE(name, op)                                      \
+JEP_KERNEL(name##_bb, JEP_B, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bi, JEP_B, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bl, JEP_B, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_bc, JEP_B, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ib, JEP_I, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ii, JEP_I, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_il, JEP_I, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ic, JEP_I, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_lb, JEP_L, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_li, JEP_L, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ll, JEP_L, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_lc, JEP_L, op, JEP_C, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cb, JEP_C, op, JEP_B, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_ci, JEP_C, op, JEP_I, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cl, JEP_C, op, JEP_L, jep_set_int, int, JEP_INT) \
+JEP_KERNEL(name##_cc, JEP_C, op, JEP_C, jep_set_int, int, JEP_INT) \
+static const jep_kernel name[JEP_NUM_TYPES][JEP_NUM_TYPES] =       \
+{                                                                  \
+	{ name##_bb, name##_bi, name##_bl, NULL, name##_bc },          \
+	{ name##_ib, name##_ii, name##_il, NULL, name##_ic },          \
+	{ name##_lb, name##_li, name##_ll, NULL, name##_lc },          \
+	{ NULL, NULL, NULL, NULL, NULL },                              \
+	{ name##_cb, name##_ci, name##_cl, NULL, name##_cc }           \
+};
+
+JEP_ARITHMETIC(jep_add_kernels, +)
+JEP_ARITHMETIC(jep_sub_kernels, -)
+JEP_ARITHMETIC(jep_mul_kernels, *)
+JEP_ARITHMETIC(jep_div_kernels, /)
+JEP_COMPARISON(jep_less_kernels, <)
+JEP_COMPARISON(jep_greater_kernels, >)
+JEP_COMPARISON(jep_lorequal_kernels, <=)
+JEP_COMPARISON(jep_gorequal_kernels, >=)
+JEP_COMPARISON(jep_equiv_kernels, ==)
+JEP_COMPARISON(jep_noteq_kernels, !=)
+JEP_BITWISE(jep_bitand_kernels, &)
+JEP_BITWISE(jep_bitor_kernels, |)
+JEP_BITWISE(jep_bitxor_kernels, ^)
+JEP_BITWISE(jep_lshift_kernels, <<)
+JEP_BITWISE(jep_rshift_kernels, >>)
 
-			if (r_str != NULL)
-			{
-				free(r_str);
-			}
+/**
+ * operand type check
+ *
+ * verifies that the type of an operand
+ * is acceptable for a given operator
+ */
+static int jep_otc(const char* operator, jep_obj* operand)
+{
+	int valid = 0;
 
-			jep_destroy_object(l);
-			jep_destroy_object(r);
+	if (operand == NULL)
+	{
+		return 0;
+	}
 
-			return result;
+	if (!strcmp("!=", operator)
+		|| !strcmp("==", operator)
+		|| !strcmp("&&", operator)
+		|| !strcmp("||", operator))
+	{
+		switch (operand->type)
+		{
+		case JEP_INT:
+		case JEP_LONG:
+		case JEP_DOUBLE:
+		case JEP_BYTE:
+		case JEP_CHARACTER:
+		case JEP_STRING:
+		case JEP_NULL:
+			valid = 1;
+		default:
+			break;
 		}
-
-		if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-			&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
+	}
+	else if (!strcmp("<", operator)
+		|| !strcmp(">", operator)
+		|| !strcmp("<=", operator)
+		|| !strcmp(">=", operator))
+	{
+		switch (operand->type)
 		{
-			printf("invalid operand types for operation -\n");
+		case JEP_INT:
+		case JEP_LONG:
+		case JEP_DOUBLE:
+		case JEP_BYTE:
+		case JEP_CHARACTER:
+			valid = 1;
+		default:
+			break;
 		}
-		else if (l->type == r->type)
+	}
+	else if (!strcmp("&", operator)
+		|| !strcmp("|", operator)
+		|| !strcmp("^", operator)
+		|| !strcmp("<<", operator)
+		|| !strcmp(">>", operator)
+		|| !strcmp("&=", operator)
+		|| !strcmp("|=", operator)
+		|| !strcmp("^=", operator)
+		|| !strcmp("<<=", operator)
+		|| !strcmp(">>=", operator)
+		|| !strcmp("++", operator)
+		|| !strcmp("--", operator))
+	{
+		switch (operand->type)
 		{
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) + (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				long *n = malloc(sizeof(long));
-				*n = (*(long *)(l->val)) + (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_LONG;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				double *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) + (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_DOUBLE;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				unsigned char *n = malloc(sizeof(unsigned char));
-				*n = (*(unsigned char *)(l->val)) + (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_DOUBLE;
-			}
+		case JEP_INT:
+		case JEP_LONG:
+		case JEP_BYTE:
+		case JEP_CHARACTER:
+			valid = 1;
+		default:
+			break;
 		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
+	}
+	else if (!strcmp("!", operator))
+	{
+		switch (operand->type)
 		{
-			double *n = malloc(sizeof(double));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) + (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) + (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) + (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) + (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_DOUBLE;
+		case JEP_INT:
+		case JEP_LONG:
+		case JEP_DOUBLE:
+		case JEP_BYTE:
+		case JEP_CHARACTER:
+		case JEP_NULL:
+			valid = 1;
+		default:
+			break;
 		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
+	}
+
+	return valid;
+}
+
+/* gets the kernel of an operator for the types of two objects */
+static jep_kernel jep_dispatch(const jep_kernel table[][JEP_NUM_TYPES],
+	jep_obj *l, jep_obj *r)
+{
+	if (!JEP_IS_NUMERIC(l->type) || !JEP_IS_NUMERIC(r->type))
+	{
+		return NULL;
+	}
+
+	return table[JEP_NUM_INDEX(l->type)][JEP_NUM_INDEX(r->type)];
+}
+
+/* applies a numeric operator to two objects */
+static jep_obj *jep_numeric(const jep_kernel table[][JEP_NUM_TYPES],
+	const char *op, jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
+
+	if (l != NULL && r != NULL)
+	{
+		jep_kernel kernel = jep_dispatch(table, l, r);
+		if (kernel != NULL)
 		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) + (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) + (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) + (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) + (*(long *)(r->val));
-				}
-			}
 			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_LONG;
+			kernel(result, l, r);
 		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
+		else
 		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) + (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) + (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) + (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) + (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_BYTE;
+			printf("invalid operand types for operation %s\n", op);
 		}
 	}
 	else
@@ -464,524 +573,33 @@ jep_obj *jep_add(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* evaluates subtraction or negation */
-jep_obj *jep_sub(jep_ast_node node, jep_obj *list)
+/* applies a bitwise operator to two objects */
+static jep_obj *jep_bitwise(const jep_kernel table[][JEP_NUM_TYPES],
+	const char *op, jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2 && node.leaf_count != 1)
-	{
-		return NULL;
-	}
+	jep_obj *result = NULL; /* result */
 
-	l = jep_evaluate(node.leaves[0], list);
-
-	if (node.leaf_count > 1)
+	/* operand type check */
+	if (!jep_otc(op, l) || !jep_otc(op, r))
 	{
-		r = jep_evaluate(node.leaves[1], list);
+		printf("invalid operand type for operator %s\n", op);
 	}
 
-	if (node.leaf_count == 1 && l != NULL)
+	if (l != NULL && r != NULL)
 	{
-		if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE)
-		{
-			printf("invalid operand types for operation -\n");
-			result = jep_create_object();
-			result->type = JEP_ARGUMENT;
-		}
-		else if (l->type == JEP_INT)
-		{
-			int *n = malloc(sizeof(int));
-			*n = 0 - (*(int *)(l->val));
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_LONG)
-		{
-			long *n = malloc(sizeof(long));
-			*n = 0 - (*(long *)(l->val));
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_LONG;
-		}
-		else if (l->type == JEP_DOUBLE)
+		jep_kernel kernel = jep_dispatch(table, l, r);
+		result = jep_create_object();
+		result->type = JEP_INT;
+		if (kernel != NULL)
 		{
-			double *n = malloc(sizeof(double));
-			*n = 0 - (*(double *)(l->val));
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_DOUBLE;
+			kernel(result, l, r);
 		}
-		else if (l->type == JEP_BYTE)
+		else
 		{
-			unsigned char *n = malloc(sizeof(unsigned char));
-			*n = 0 - (*(unsigned char *)(l->val));
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_BYTE;
+			jep_set_int(result, 0);
 		}
 	}
-	else if (l != NULL && r != NULL)
-	{
-		if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-			&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-		{
-			printf("invalid operand types for operation -\n");
-		}
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) - (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				long *n = malloc(sizeof(long));
-				*n = (*(long *)(l->val)) - (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_LONG;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				double *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) - (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_DOUBLE;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				unsigned char *n = malloc(sizeof(unsigned char));
-				*n = (*(unsigned char *)(l->val)) - (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			double *n = malloc(sizeof(double));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) - (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) - (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) - (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) - (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_DOUBLE;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) - (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) - (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) - (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) - (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_LONG;
-		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
-		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) - (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) - (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) - (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) - (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_BYTE;
-		}
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
-
-	/* free the memory of the operands */
-	if (l != NULL)
-	{
-		jep_destroy_object(l);
-	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
-	}
-
-	return result;
-}
-
-/* evaluates a multiplication expression */
-jep_obj *jep_mul(jep_ast_node node, jep_obj *list)
-{
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
-	{
-		return NULL;
-	}
-
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-			&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-		{
-			printf("invalid operand types for operation -\n");
-		}
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) * (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				long *n = malloc(sizeof(long));
-				*n = (*(long *)(l->val)) * (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_LONG;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				double *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) * (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_DOUBLE;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				unsigned char *n = malloc(sizeof(unsigned char));
-				*n = (*(unsigned char *)(l->val)) * (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			double *n = malloc(sizeof(double));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) * (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) * (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) * (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) * (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_DOUBLE;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			printf("multiplying a long with an int\n");
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) * (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) * (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) * (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) * (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_LONG;
-		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
-		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) * (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) * (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) * (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) * (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_BYTE;
-		}
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
-
-	/* free the memory of the operands */
-	if (l != NULL)
-	{
-		jep_destroy_object(l);
-	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
-	}
-
-	return result;
-}
-
-/* evaluates a division expression */
-jep_obj *jep_div(jep_ast_node node, jep_obj *list)
-{
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
-	{
-		return NULL;
-	}
-
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		if (l->type == r->type)
-		{
-			if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-				&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-			{
-				printf("invalid operand types for operation -\n");
-			}
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) / (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				long *n = malloc(sizeof(long));
-				*n = (*(long *)(l->val)) / (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_LONG;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				double *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) / (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_DOUBLE;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				unsigned char *n = malloc(sizeof(unsigned char));
-				*n = (*(unsigned char *)(l->val)) / (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			double *n = malloc(sizeof(double));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) / (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) / (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) / (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) / (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_DOUBLE;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) / (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) / (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) / (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) / (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_LONG;
-		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
-		{
-			long *n = malloc(sizeof(long));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) / (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) / (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) / (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) / (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_BYTE;
-		}
-	}
-	else
+	else
 	{
 		printf("could not obtain both operand values\n");
 	}
@@ -999,686 +617,372 @@ jep_obj *jep_div(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* evaluates a modulus expression */
-jep_obj *jep_modulus(jep_ast_node node, jep_obj *list)
+/* gets the truth value of an object for a logical operator */
+static int jep_truth(jep_obj *o)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
-	{
-		return NULL;
-	}
-
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		if (l->type == r->type && l->type == JEP_INT)
-		{
-			int *n = malloc(sizeof(int));
-			*n = (*(int *)(l->val)) % (*(int *)(r->val));
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else
-		{
-			printf("invalid operand types for %% operator\n");
-		}
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
-
-	/* free the memory of the operands */
-	if (l != NULL)
-	{
-		jep_destroy_object(l);
-	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
+	switch (o->type)
+	{
+	case JEP_INT:
+		return JEP_I(o) != 0;
+	case JEP_LONG:
+		return JEP_L(o) != 0;
+	case JEP_DOUBLE:
+		return JEP_D(o) != 0;
+	case JEP_BYTE:
+		return JEP_B(o) != 0;
+	case JEP_CHARACTER:
+		return JEP_C(o) != 0;
+	case JEP_STRING:
+		return ((char *)(o->val))[0] != '\0';
+	default:
+		return 0;
 	}
-
-	return result;
 }
 
-/* evaluates a less than expression */
-jep_obj *jep_less(jep_ast_node node, jep_obj *list)
+/*
+ * checks if either operand of a binary operator threw an exception.
+ * the other operand is destroyed and the exception is left in l, so
+ * it is passed on the same way the VM passes on a thrown operand.
+ */
+static int jep_thrown(jep_obj **l, jep_obj **r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
-	{
-		return NULL;
-	}
-
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		if (l->type == r->type)
-		{
-			if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-				&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-			{
-				printf("invalid operand types for operation -\n");
-			}
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) < (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(long *)(l->val)) < (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				int *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) < (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(unsigned char *)(l->val)) < (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) < (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) < (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) < (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) < (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) < (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) < (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) < (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) < (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) < (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) < (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) < (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) < (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-	}
-	else
+	if (*l != NULL && (*l)->ret & JEP_EXCEPTION)
 	{
-		printf("could not obtain both operand values\n");
+		jep_destroy_object(*r);
+		return 1;
 	}
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	if (*r != NULL && (*r)->ret & JEP_EXCEPTION)
 	{
-		jep_destroy_object(l);
-	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
+		jep_destroy_object(*l);
+		*l = *r;
+		return 1;
 	}
 
-	return result;
+	return 0;
 }
 
-/* evaluates a less than expression */
-jep_obj *jep_greater(jep_ast_node node, jep_obj *list)
+/* checks if an operator can specialize itself for two ints */
+static int jep_quickens(int token_code)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
+	switch (token_code)
 	{
-		return NULL;
-	}
-
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
-
-	if (l != NULL && r != NULL)
-	{
-		if (l->type == r->type)
-		{
-			if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-				&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-			{
-				printf("invalid operand types for operation -\n");
-			}
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) > (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(long *)(l->val)) > (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				int *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) > (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(unsigned char *)(l->val)) > (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) > (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) > (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) > (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) > (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) > (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) > (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) > (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) > (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) > (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) > (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) > (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) > (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
+	case T_PLUS:
+	case T_MINUS:
+	case T_STAR:
+	case T_LESS:
+	case T_GREATER:
+	case T_LOREQUAL:
+	case T_GOREQUAL:
+	case T_EQUIVALENT:
+	case T_NOTEQUIVALENT:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * evaluates an operand of a quickened operator.
+ * the value of an int is stored in n without creating an object
+ * for it, and variables and literals are read in place.
+ * any other value is returned as a new object.
+ */
+static jep_obj *jep_quick_operand(jep_ast_node *node, jep_obj *list,
+	int *n, int *is_int)
+{
+	jep_obj *o;
+
+	*is_int = 0;
+
+	if (node->token.type == T_IDENTIFIER)
+	{
+		o = jep_lookup(node, list);
+	}
+	else if (node->value != NULL)
+	{
+		o = node->value;
 	}
 	else
 	{
-		printf("could not obtain both operand values\n");
+		o = jep_evaluate(node, list);
+		if (o != NULL && o->type == JEP_INT)
+		{
+			*n = JEP_I(o);
+			*is_int = 1;
+			jep_destroy_object(o);
+			return NULL;
+		}
+		return o;
 	}
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	if (o != NULL && o->type == JEP_INT)
 	{
-		jep_destroy_object(l);
+		*n = JEP_I(o);
+		*is_int = 1;
+		return NULL;
 	}
-	if (r != NULL)
+
+	/* copy the value before the other operand can change it */
+	if (o != NULL)
 	{
-		jep_destroy_object(r);
+		o = node->value != NULL ? jep_literal(node) : jep_identifier(node, list);
 	}
 
-	return result;
+	return o;
 }
 
-/* evaluates a less than or equal to expression */
-jep_obj *jep_lorequal(jep_ast_node node, jep_obj *list)
+/* applies a binary operator to two objects */
+static jep_obj *jep_binary_objects(int token_code, jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	if (jep_thrown(&l, &r))
+	{
+		return l;
+	}
 
-	if (node.leaf_count != 2)
+	switch (token_code)
 	{
+	case T_PLUS:
+		return jep_add_objects(l, r);
+	case T_MINUS:
+		return jep_sub_objects(l, r);
+	case T_STAR:
+		return jep_mul_objects(l, r);
+	case T_LESS:
+		return jep_less_objects(l, r);
+	case T_GREATER:
+		return jep_greater_objects(l, r);
+	case T_LOREQUAL:
+		return jep_lorequal_objects(l, r);
+	case T_GOREQUAL:
+		return jep_gorequal_objects(l, r);
+	case T_EQUIVALENT:
+		return jep_equiv_objects(l, r);
+	case T_NOTEQUIVALENT:
+		return jep_noteq_objects(l, r);
+	default:
 		return NULL;
 	}
+}
+
+/*
+ * evaluates a binary operator that specializes itself for two ints.
+ * once a node has only seen ints it skips the generic dispatch, and
+ * the first operands of any other type send it back to the generic
+ * operator for good.
+ */
+jep_obj *jep_quick_int(jep_ast_node *node, jep_obj *list)
+{
+	jep_obj *l;       /* left operand  */
+	jep_obj *r;       /* right operand */
+	jep_obj *result;  /* result        */
+	int a = 0, b = 0; /* int operands  */
+	int l_int, r_int;
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_quick_operand(&(node->leaves[0]), list, &a, &l_int);
+	r = jep_quick_operand(&(node->leaves[1]), list, &b, &r_int);
 
-	if (l != NULL && r != NULL)
+	if (!l_int || !r_int)
 	{
-		if (l->type == r->type)
-		{
-			if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-				&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-			{
-				printf("invalid operand types for operation >=\n");
-			}
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) <= (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(long *)(l->val)) <= (*(long *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				int *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) <= (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(unsigned char *)(l->val)) <= (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
-			}
-		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) <= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) <= (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) <= (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) <= (*(double *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
+		node->quick = JEP_QUICK_GENERIC;
+
+		if (l_int)
 		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) <= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) <= (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) <= (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) <= (*(long *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
+			l = jep_create_object();
+			l->type = JEP_INT;
+			jep_set_int(l, a);
 		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
+		if (r_int)
 		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) <= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) <= (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) <= (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) <= (*(unsigned char *)(r->val));
-				}
-			}
-			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
+			r = jep_create_object();
+			r->type = JEP_INT;
+			jep_set_int(r, b);
 		}
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
 
-	/* free the memory of the operands */
-	if (l != NULL)
-	{
-		jep_destroy_object(l);
+		return jep_binary_objects(node->token.token_code, l, r);
 	}
-	if (r != NULL)
+
+	node->quick = JEP_QUICK_INT;
+
+	result = jep_create_object();
+	result->type = JEP_INT;
+
+	switch (node->token.token_code)
 	{
-		jep_destroy_object(r);
+	case T_PLUS:
+		jep_set_int(result, a + b);
+		break;
+	case T_MINUS:
+		jep_set_int(result, a - b);
+		break;
+	case T_STAR:
+		jep_set_int(result, a * b);
+		break;
+	case T_LESS:
+		jep_set_int(result, a < b);
+		break;
+	case T_GREATER:
+		jep_set_int(result, a > b);
+		break;
+	case T_LOREQUAL:
+		jep_set_int(result, a <= b);
+		break;
+	case T_GOREQUAL:
+		jep_set_int(result, a >= b);
+		break;
+	case T_EQUIVALENT:
+		jep_set_int(result, a == b);
+		break;
+	case T_NOTEQUIVALENT:
+		jep_set_int(result, a != b);
+		break;
 	}
 
 	return result;
 }
 
-/* evaluates a greater than or equal to expression */
-jep_obj *jep_gorequal(jep_ast_node node, jep_obj *list)
+/* evaluates an addition expression */
+jep_obj *jep_add(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
+	{
+		return l;
+	}
+
+	return jep_add_objects(l, r);
+}
+
+/* adds two objects */
+jep_obj *jep_add_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
 
 	if (l != NULL && r != NULL)
 	{
-		if (l->type == r->type)
+		/* string concatenation */
+		if (l->type == JEP_STRING || r->type == JEP_STRING)
 		{
-			if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE
-				&& r->type != JEP_INT && r->type != JEP_LONG && r->type != JEP_DOUBLE && r->type != JEP_BYTE)
-			{
-				printf("invalid operand types for operation >=\n");
-			}
-			if (l->type == JEP_INT)
-			{
-				int *n = malloc(sizeof(int));
-				*n = (*(int *)(l->val)) >= (*(int *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
-			}
-			else if (l->type == JEP_LONG)
+			char *l_str = jep_to_string(l);
+			char *r_str = jep_to_string(r);
+
+			if (l_str != NULL && r_str != NULL)
 			{
-				int *n = malloc(sizeof(int));
-				*n = (*(long *)(l->val)) >= (*(long *)(r->val));
+				/* the result is shared, so assigning it doesn't copy it */
+				size_t l_len = strlen(l_str);
+				size_t r_len = strlen(r_str);
+				char *str;
+
 				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
+				str = jep_string_buffer(result, l_len + r_len);
+				memcpy(str, l_str, l_len);
+				memcpy(str + l_len, r_str, r_len);
 			}
-			else if (l->type == JEP_DOUBLE)
+
+			if (l_str != NULL)
 			{
-				int *n = malloc(sizeof(double));
-				*n = (*(double *)(l->val)) >= (*(double *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_INT;
+				free(l_str);
 			}
-			else if (l->type == JEP_BYTE)
+
+			if (r_str != NULL)
 			{
-				int *n = malloc(sizeof(int));
-				*n = (*(unsigned char *)(l->val)) >= (*(unsigned char *)(r->val));
-				result = jep_create_object();
-				result->val = (void *)n;
-				result->type = JEP_BYTE;
+				free(r_str);
 			}
+
+			jep_destroy_object(l);
+			jep_destroy_object(r);
+
+			return result;
 		}
-		else if (l->type == JEP_DOUBLE || r->type == JEP_DOUBLE)
+
+	}
+
+	return jep_numeric(jep_add_kernels, "+", l, r);
+}
+
+/* evaluates subtraction or negation */
+jep_obj *jep_sub(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
+
+	if (node.leaf_count != 2 && node.leaf_count != 1)
+	{
+		return NULL;
+	}
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+
+	if (node.leaf_count == 1)
+	{
+		return jep_neg_object(l);
+	}
+
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
+	{
+		return l;
+	}
+
+	return jep_sub_objects(l, r);
+}
+
+/* negates an object */
+jep_obj *jep_neg_object(jep_obj *l)
+{
+	jep_obj *result = NULL; /* result */
+
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		return l;
+	}
+
+	if (l != NULL)
+	{
+		if (l->type != JEP_INT && l->type != JEP_LONG && l->type != JEP_DOUBLE && l->type != JEP_BYTE)
 		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(double *)(l->val)) >= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(double *)(l->val)) >= (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_DOUBLE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) >= (*(double *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) >= (*(double *)(r->val));
-				}
-			}
+			printf("invalid operand types for operation -\n");
 			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
-		}
-		else if (l->type == JEP_LONG || r->type == JEP_LONG)
-		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(long *)(l->val)) >= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) >= (*(long *)(r->val));
-				}
-			}
-			else if (r->type == JEP_LONG)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) >= (*(long *)(r->val));
-				}
-				else if (l->type == JEP_LONG)
-				{
-					*n = (*(long *)(l->val)) >= (*(long *)(r->val));
-				}
-			}
+			result->type = JEP_ARGUMENT;
+		}
+		else if (l->type == JEP_INT)
+		{
+			int n = 0 - (*(int *)(l->val));
 			result = jep_create_object();
-			result->val = (void *)n;
+			jep_set_int(result, n);
 			result->type = JEP_INT;
 		}
-		else if (l->type == JEP_BYTE || r->type == JEP_BYTE)
+		else if (l->type == JEP_LONG)
 		{
-			int *n = malloc(sizeof(int));
-			if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)
-				{
-					*n = (*(unsigned char *)(l->val)) >= (*(int *)(r->val));
-				}
-				else if (r->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) >= (*(unsigned char *)(r->val));
-				}
-			}
-			else if (r->type == JEP_BYTE)
-			{
-				if (l->type == JEP_INT)
-				{
-					*n = (*(int *)(l->val)) >= (*(unsigned char *)(r->val));
-				}
-				else if (l->type == JEP_BYTE)
-				{
-					*n = (*(unsigned char *)(l->val)) >= (*(unsigned char *)(r->val));
-				}
-			}
+			long n = 0 - (*(long *)(l->val));
 			result = jep_create_object();
-			result->val = (void *)n;
-			result->type = JEP_INT;
+			jep_set_long(result, n);
+			result->type = JEP_LONG;
+		}
+		else if (l->type == JEP_DOUBLE)
+		{
+			double n = 0 - (*(double *)(l->val));
+			result = jep_create_object();
+			jep_set_double(result, n);
+			result->type = JEP_DOUBLE;
+		}
+		else if (l->type == JEP_BYTE)
+		{
+			unsigned char n = 0 - (*(unsigned char *)(l->val));
+			result = jep_create_object();
+			jep_set_byte(result, n);
+			result->type = JEP_BYTE;
 		}
 	}
 	else
@@ -1686,201 +990,117 @@ jep_obj *jep_gorequal(jep_ast_node node, jep_obj *list)
 		printf("could not obtain both operand values\n");
 	}
 
-	/* free the memory of the operands */
+	/* free the memory of the operand */
 	if (l != NULL)
 	{
 		jep_destroy_object(l);
 	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
-	}
 
 	return result;
 }
 
-/**
- * operand type check
- *
- * verifies that the type of an operand
- * is acceptable for a given operator
- */
-static int jep_otc(const char* operator, jep_obj* operand)
+/* subtracts one object from another */
+jep_obj *jep_sub_objects(jep_obj *l, jep_obj *r)
 {
-	int valid = 0;
+	return jep_numeric(jep_sub_kernels, "-", l, r);
+}
 
-	if (operand == NULL)
-	{
-		return 0;
-	}
+/* evaluates a multiplication expression */
+jep_obj *jep_mul(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
-	if (!strcmp("!=", operator)
-		|| !strcmp("==", operator)
-		|| !strcmp("&&", operator)
-		|| !strcmp("||", operator))
+	if (node.leaf_count != 2)
 	{
-		switch (operand->type)
-		{
-		case JEP_INT:
-		case JEP_LONG:
-		case JEP_DOUBLE:
-		case JEP_BYTE:
-		case JEP_CHARACTER:
-		case JEP_STRING:
-		case JEP_NULL:
-			valid = 1;
-		default:
-			break;
-		}
+		return NULL;
 	}
-	else if (!strcmp("<", operator)
-		|| !strcmp(">", operator)
-		|| !strcmp("<=", operator)
-		|| !strcmp(">=", operator))
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		switch (operand->type)
-		{
-		case JEP_INT:
-		case JEP_LONG:
-		case JEP_DOUBLE:
-		case JEP_BYTE:
-		case JEP_CHARACTER:
-			valid = 1;
-		default:
-			break;
-		}
+		return l;
 	}
-	else if (!strcmp("&", operator)
-		|| !strcmp("|", operator)
-		|| !strcmp("^", operator)
-		|| !strcmp("<<", operator)
-		|| !strcmp(">>", operator)
-		|| !strcmp("&=", operator)
-		|| !strcmp("|=", operator)
-		|| !strcmp("^=", operator)
-		|| !strcmp("<<=", operator)
-		|| !strcmp(">>=", operator)
-		|| !strcmp("++", operator)
-		|| !strcmp("--", operator))
+
+	return jep_mul_objects(l, r);
+}
+
+/* multiplies two objects */
+jep_obj *jep_mul_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_numeric(jep_mul_kernels, "*", l, r);
+}
+
+/* evaluates a division expression */
+jep_obj *jep_div(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
+
+	if (node.leaf_count != 2)
 	{
-		switch (operand->type)
-		{
-		case JEP_INT:
-		case JEP_LONG:
-		case JEP_BYTE:
-		case JEP_CHARACTER:
-			valid = 1;
-		default:
-			break;
-		}
+		return NULL;
 	}
-	else if (!strcmp("!", operator))
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		switch (operand->type)
-		{
-		case JEP_INT:
-		case JEP_LONG:
-		case JEP_DOUBLE:
-		case JEP_BYTE:
-		case JEP_CHARACTER:
-		case JEP_NULL:
-			valid = 1;
-		default:
-			break;
-		}
+		return l;
 	}
 
-	return valid;
+	return jep_div_objects(l, r);
 }
 
-/* evaluates an equivalence expression */
-jep_obj *jep_equiv(jep_ast_node node, jep_obj *list)
+/* divides two objects */
+jep_obj *jep_div_objects(jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	return jep_numeric(jep_div_kernels, "/", l, r);
+}
+
+/* evaluates a modulus expression */
+jep_obj *jep_modulus(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("==", l) || !jep_otc("==", r))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator ==\n");
+		return l;
 	}
 
+	return jep_modulus_objects(l, r);
+}
+
+/* performs a modulus operation on two objects */
+jep_obj *jep_modulus_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
+
 	if (l != NULL && r != NULL)
 	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
-
-		if (l->type == r->type)
-		{
-			/* handle operands of the same type */
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) == (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) == (*(long *)(r->val));
-			else if (l->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) == (*(double *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) == (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) == (*(char *)(r->val));
-			else if (l->type == JEP_STRING)    *n = !strcmp((char *)(l->val), (char *)(r->val));
-			else if (l->type == JEP_NULL)      *n = 1;
-		}
-		else if (l->type == JEP_STRING || r->type == JEP_STRING
-			|| l->type == JEP_NULL || r->type == JEP_NULL)
+		if (l->type == r->type && l->type == JEP_INT)
 		{
-			/* handle null and string */
-			*n = 0;
+			int n = (*(int *)(l->val)) % (*(int *)(r->val));
+			result = jep_create_object();
+			jep_set_int(result, n);
+			result->type = JEP_INT;
 		}
 		else
 		{
-			/*
-			 * handle operands of different types
-			 * (e.g. int, long, double, byte, or character)
-			 */
-			if (l->type == JEP_INT)
-			{
-				if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) == (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(int *)(l->val)) == (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) == (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) == (*(char *)(r->val));
-			}
-			else if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)            *n = (*(long *)(l->val)) == (*(int *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(long *)(l->val)) == (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) == (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) == (*(char *)(r->val));
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)            *n = (*(double *)(l->val)) == (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(double *)(l->val)) == (*(long *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(double *)(l->val)) == (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(double *)(l->val)) == (*(char *)(r->val));
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) == (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) == (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(unsigned char *)(l->val)) == (*(double *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) == (*(char *)(r->val));
-			}
-			else if (l->type == JEP_CHARACTER)
-			{
-				if (r->type == JEP_INT)         *n = (*(char *)(l->val)) == (*(int *)(r->val));
-				else if (r->type == JEP_LONG)   *n = (*(char *)(l->val)) == (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE) *n = (*(char *)(l->val)) == (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)   *n = (*(char *)(l->val)) == (*(unsigned char *)(r->val));
-			}
+			printf("invalid operand types for %% operator\n");
 		}
-
-		result->val = (void *)n;
 	}
 	else
 	{
@@ -1900,318 +1120,179 @@ jep_obj *jep_equiv(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* evaluates a not equivalence expression */
-jep_obj *jep_noteq(jep_ast_node node, jep_obj *list)
+/* evaluates a less than expression */
+jep_obj *jep_less(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("!=", l) || !jep_otc("!=", r))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator !=\n");
+		return l;
 	}
 
-	if (l != NULL && r != NULL)
-	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
+	return jep_less_objects(l, r);
+}
 
-		if (l->type == r->type)
-		{
-			/* handle operands of the same type */
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) != (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) != (*(long *)(r->val));
-			else if (l->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) != (*(double *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) != (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) != (*(char *)(r->val));
-			else if (l->type == JEP_STRING)    *n = !!strcmp((char *)(l->val), (char *)(r->val));
-			else if (l->type == JEP_NULL)      *n = 0;
-		}
-		else if (l->type == JEP_STRING || r->type == JEP_STRING
-			|| l->type == JEP_NULL || r->type == JEP_NULL)
-		{
-			/* handle null and string */
-			*n = 1;
-		}
-		else
-		{
-			/*
-			* handle operands of different types
-			* (e.g. int, long, double, byte, or character)
-			*/
-			if (l->type == JEP_INT)
-			{
-				if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) != (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(int *)(l->val)) != (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) != (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) != (*(char *)(r->val));
-			}
-			else if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)            *n = (*(long *)(l->val)) != (*(int *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(long *)(l->val)) != (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) != (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) != (*(char *)(r->val));
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)            *n = (*(double *)(l->val)) != (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(double *)(l->val)) != (*(long *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(double *)(l->val)) != (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(double *)(l->val)) != (*(char *)(r->val));
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) != (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) != (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(unsigned char *)(l->val)) != (*(double *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) != (*(char *)(r->val));
-			}
-			else if (l->type == JEP_CHARACTER)
-			{
-				if (r->type == JEP_INT)         *n = (*(char *)(l->val)) != (*(int *)(r->val));
-				else if (r->type == JEP_LONG)   *n = (*(char *)(l->val)) != (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE) *n = (*(char *)(l->val)) != (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)   *n = (*(char *)(l->val)) != (*(unsigned char *)(r->val));
-			}
-		}
+/* compares two objects using less than */
+jep_obj *jep_less_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_numeric(jep_less_kernels, "<", l, r);
+}
 
-		result->val = (void *)n;
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
+/* evaluates a less than expression */
+jep_obj *jep_greater(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	if (node.leaf_count != 2)
 	{
-		jep_destroy_object(l);
+		return NULL;
 	}
-	if (r != NULL)
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		jep_destroy_object(r);
+		return l;
 	}
 
-	return result;
+	return jep_greater_objects(l, r);
 }
 
-/* performs a not operation */
-jep_obj *jep_not(jep_ast_node node, jep_obj *list)
+/* compares two objects using greater than */
+jep_obj *jep_greater_objects(jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* operand  */
-	jep_obj *result = NULL; /* result   */
+	return jep_numeric(jep_greater_kernels, ">", l, r);
+}
 
-	if (node.leaf_count != 1)
+/* evaluates a less than or equal to expression */
+jep_obj *jep_lorequal(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
+
+	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("!", l))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator !\n");
+		return l;
 	}
 
-	int *n = malloc(sizeof(int));
-	result = jep_create_object();
-	result->type = JEP_INT;
+	return jep_lorequal_objects(l, r);
+}
 
-	if (l != NULL)
-	{
-		if (l->type == JEP_INT)            *n = !(*(int *)(l->val));
-		else if (l->type == JEP_LONG)      *n = !(*(long *)(l->val));
-		else if (l->type == JEP_DOUBLE)    *n = !(*(double *)(l->val));
-		else if (l->type == JEP_BYTE)      *n = !(*(unsigned char *)(l->val));
-		else if (l->type == JEP_CHARACTER) *n = !(*(char *)(l->val));
-		else if (l->type == JEP_NULL)      *n = 0;
+/* compares two objects using less than or equal to */
+jep_obj *jep_lorequal_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_numeric(jep_lorequal_kernels, "<=", l, r);
+}
+
+/* evaluates a greater than or equal to expression */
+jep_obj *jep_gorequal(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
-		result->val = (void *)n;
-	}
-	else
+	if (node.leaf_count != 2)
 	{
-		printf("could not obtain operand val\n");
+		return NULL;
 	}
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		jep_destroy_object(l);
+		return l;
 	}
 
-	return result;
+	return jep_gorequal_objects(l, r);
 }
 
-/* performs a logical and operation */
-jep_obj *jep_and(jep_ast_node node, jep_obj *list)
+/* compares two objects using greater than or equal to */
+jep_obj *jep_gorequal_objects(jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	return jep_numeric(jep_gorequal_kernels, ">=", l, r);
+}
+
+/* evaluates an equivalence expression */
+jep_obj *jep_equiv(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("&&", l))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator &&\n");
+		return l;
 	}
 
-	int *n = malloc(sizeof(int));
-	*n = -1;
-	result = jep_create_object();
-	result->type = JEP_INT;
+	return jep_equiv_objects(l, r);
+}
 
-	/* check result of left operand first */
-	if (l != NULL)
-	{
-		switch (l->type)
-		{
-		case JEP_INT:
-			if ((*(int *)(l->val)) == 0) *n = 0;
-			break;
-		case JEP_LONG:
-			if ((*(long *)(l->val)) == 0) *n = 0;
-			break;
-		case JEP_DOUBLE:
-			if ((*(double *)(l->val)) == 0) *n = 0;
-			break;
-		case JEP_BYTE:
-			if ((*(unsigned char *)(l->val)) == 0) *n = 0;
-			break;
-		case JEP_CHARACTER:
-			if ((*(char *)(l->val)) == 0) *n = 0;
-			break;
-		case JEP_STRING:
-			if (strlen((char *)(l->val)) < 1) *n = 0;
-			break;
-		case JEP_NULL:
-			*n = 0;
-			break;
-		default:
-			break;
-		}
-	}
+/* compares two objects for equivalence */
+jep_obj *jep_equiv_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
 
-	/* return if the left operand is false */
-	if (*n > -1)
+	/* operand type check */
+	if (!jep_otc("==", l) || !jep_otc("==", r))
 	{
-		result->val = (void *)n;
-		jep_destroy_object(l);
-		return result;
+		printf("invalid operand type for operator ==\n");
 	}
-	else *n = 0;
-
-	r = jep_evaluate(node.leaves[1], list);
 
 	if (l != NULL && r != NULL)
 	{
-		/* operand type check */
-		if (!jep_otc("&&", r))
-		{
-			printf("invalid operand type for operator &&\n");
-		}
+		jep_kernel kernel = jep_dispatch(jep_equiv_kernels, l, r);
+		int n = 0;
+		result = jep_create_object();
+		result->type = JEP_INT;
 
-		if (l->type == r->type)
-		{
-			/* handle operands of the same type */
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) && (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) && (*(long *)(r->val));
-			else if (l->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) && (*(double *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) && (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) && (*(char *)(r->val));
-			else if (l->type == JEP_STRING)
-			{
-				if (strlen((char *)(l->val)) < 1 || strlen((char *)(r->val)) < 1)
-				{
-					*n = 0;
-				}
-				else *n = 1;
-			}
-			else if (l->type == JEP_NULL) *n = 0;
-		}
-		else if (l->type == JEP_NULL || r->type == JEP_NULL)
+		if (kernel != NULL)
 		{
-			/* handle null */
-			*n = 0;
+			kernel(result, l, r);
 		}
 		else
 		{
-			/*
-			* handle operands of different types
-			* (e.g. int, long, double, byte, or character)
-			*/
-			if (l->type == JEP_INT)
+			/* handle strings and null */
+			if (l->type == JEP_STRING && r->type == JEP_STRING)
 			{
-				if (r->type == JEP_INT)            *n = (*(int *)(l->val)) && (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(int *)(l->val)) && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(int *)(l->val)) && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) && (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(int *)(l->val)) && strlen((char *)(r->val)) > 0;
+				n = !strcmp((char *)(l->val), (char *)(r->val));
 			}
-			else if (l->type == JEP_LONG)
+			else if (l->type == JEP_NULL && r->type == JEP_NULL)
 			{
-				if (r->type == JEP_INT)            *n = (*(long *)(l->val)) && (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(long *)(l->val)) && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(long *)(l->val)) && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) && (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(long *)(l->val)) && strlen((char *)(r->val)) > 0;
+				n = 1;
 			}
-			else if (l->type == JEP_DOUBLE)
+			else if (l->type == JEP_STRING || r->type == JEP_STRING
+				|| l->type == JEP_NULL || r->type == JEP_NULL)
 			{
-				if (r->type == JEP_INT)            *n = (*(double *)(l->val)) && (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(double *)(l->val)) && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(double *)(l->val)) && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(double *)(l->val)) && (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(double *)(l->val)) && strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) && (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(unsigned char *)(l->val)) && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) && (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(unsigned char *)(l->val)) && strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_CHARACTER)
-			{
-				if (r->type == JEP_INT)            *n = (*(char *)(l->val)) && (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(char *)(l->val)) && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(char *)(l->val)) && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(char *)(l->val)) && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(char *)(l->val)) && (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(char *)(l->val)) && strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_STRING)
-			{
-				if (r->type == JEP_LONG)        *n = strlen((char *)(l->val)) > 0 && (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE) *n = strlen((char *)(l->val)) > 0 && (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)   *n = strlen((char *)(l->val)) > 0 && (*(unsigned char *)(r->val));
-				else if (r->type == JEP_INT)    *n = strlen((char *)(l->val)) > 0 && (*(int *)(r->val));
-				else if (r->type == JEP_STRING) *n = strlen((char *)(l->val)) > 0 && strlen((char *)(r->val)) > 0;
+				n = 0;
 			}
+			jep_set_int(result, n);
 		}
 	}
 	else
@@ -2219,8 +1300,6 @@ jep_obj *jep_and(jep_ast_node node, jep_obj *list)
 		printf("could not obtain both operand values\n");
 	}
 
-	result->val = (void *)n;
-
 	/* free the memory of the operands */
 	if (l != NULL)
 	{
@@ -2234,168 +1313,67 @@ jep_obj *jep_and(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* performs a logical or operation */
-jep_obj *jep_or(jep_ast_node node, jep_obj *list)
+/* evaluates a not equivalence expression */
+jep_obj *jep_noteq(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("||", l))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator ||\n");
+		return l;
 	}
 
-	int *n = malloc(sizeof(int));
-	*n = -1;
-	result = jep_create_object();
-	result->type = JEP_INT;
+	return jep_noteq_objects(l, r);
+}
 
-	/* check result of left operand first */
-	if (l != NULL)
-	{
-		switch (l->type)
-		{
-		case JEP_INT:
-			if ((*(int *)(l->val)) != 0) *n = 1;
-			break;
-		case JEP_LONG:
-			if ((*(long *)(l->val)) != 0) *n = 1;
-			break;
-		case JEP_DOUBLE:
-			if ((*(double *)(l->val)) != 0) *n = 1;
-			break;
-		case JEP_BYTE:
-			if ((*(unsigned char *)(l->val)) != 0) *n = 1;
-			break;
-		case JEP_CHARACTER:
-			if ((*(char *)(l->val)) != 0) *n = 1;
-			break;
-		case JEP_STRING:
-			if (strlen((char *)(l->val)) > 0) *n = 1;
-			break;
-		case JEP_NULL:
-			*n = 0;
-			break;
-		default:
-			break;
-		}
-	}
+/* compares two objects for non-equivalence */
+jep_obj *jep_noteq_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
 
-	/* return if the left operand is false */
-	if (*n > -1)
+	/* operand type check */
+	if (!jep_otc("!=", l) || !jep_otc("!=", r))
 	{
-		result->val = (void *)n;
-		jep_destroy_object(l);
-		return result;
+		printf("invalid operand type for operator !=\n");
 	}
-	else *n = 0;
-
-	r = jep_evaluate(node.leaves[1], list);
 
 	if (l != NULL && r != NULL)
 	{
-		/* operand type check */
-		if (!jep_otc("||", r))
-		{
-			printf("invalid operand type for operator &&\n");
-		}
+		jep_kernel kernel = jep_dispatch(jep_noteq_kernels, l, r);
+		int n = 0;
+		result = jep_create_object();
+		result->type = JEP_INT;
 
-		if (l->type == r->type)
+		if (kernel != NULL)
 		{
-			/* handle operands of the same type */
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) || (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) || (*(long *)(r->val));
-			else if (l->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) || (*(double *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) || (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) || (*(char *)(r->val));
-			else if (l->type == JEP_STRING)
-			{
-				if (strlen((char *)(l->val)) > 0 || strlen((char *)(r->val)) > 0)
-				{
-					*n = 1;
-				}
-				else *n = 0;
-			}
-			else if (l->type == JEP_NULL) *n = 0;
+			kernel(result, l, r);
 		}
 		else
 		{
-			/*
-			* handle operands of different types
-			* (e.g. int, long, double, byte, or character)
-			*/
-			if (l->type == JEP_INT)
-			{
-				if (r->type == JEP_INT)            *n = (*(int *)(l->val)) || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(int *)(l->val)) || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(int *)(l->val)) || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(int *)(l->val)) || strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_LONG)
-			{
-				if (r->type == JEP_INT)            *n = (*(long *)(l->val)) || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(long *)(l->val)) || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(long *)(l->val)) || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(long *)(l->val)) || strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_DOUBLE)
-			{
-				if (r->type == JEP_INT)            *n = (*(double *)(l->val)) || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(double *)(l->val)) || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(double *)(l->val)) || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(double *)(l->val)) || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(double *)(l->val)) || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(double *)(l->val)) || strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_BYTE)
-			{
-				if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(unsigned char *)(l->val)) || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(unsigned char *)(l->val)) || strlen((char *)(r->val)) > 0;
-			}
-			else if (l->type == JEP_CHARACTER)
+			/* handle strings and null */
+			if (l->type == JEP_STRING && r->type == JEP_STRING)
 			{
-				if (r->type == JEP_INT)            *n = (*(char *)(l->val)) || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = (*(char *)(l->val)) || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = (*(char *)(l->val)) || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = (*(char *)(l->val)) || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = (*(char *)(l->val)) || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = (*(char *)(l->val)) || strlen((char *)(r->val)) > 0;
+				n = !!strcmp((char *)(l->val), (char *)(r->val));
 			}
-			else if (l->type == JEP_STRING)
+			else if (l->type == JEP_NULL && r->type == JEP_NULL)
 			{
-				if (r->type == JEP_INT)            *n = strlen((char *)(l->val)) > 0 || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = strlen((char *)(l->val)) > 0 || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = strlen((char *)(l->val)) > 0 || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = strlen((char *)(l->val)) > 0 || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = strlen((char *)(l->val)) > 0 || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = strlen((char *)(l->val)) > 0 || strlen((char *)(r->val)) > 0;
+				n = 0;
 			}
-			else if (l->type == JEP_NULL)
+			else if (l->type == JEP_STRING || r->type == JEP_STRING
+				|| l->type == JEP_NULL || r->type == JEP_NULL)
 			{
-				if (r->type == JEP_INT)            *n = 0 || (*(int *)(r->val));
-				else if (r->type == JEP_LONG)      *n = 0 || (*(long *)(r->val));
-				else if (r->type == JEP_DOUBLE)    *n = 0 || (*(double *)(r->val));
-				else if (r->type == JEP_BYTE)      *n = 0 || (*(unsigned char *)(r->val));
-				else if (r->type == JEP_CHARACTER) *n = 0 || (*(char *)(r->val));
-				else if (r->type == JEP_STRING)    *n = 0 || strlen((char *)(r->val)) > 0;
+				n = 1;
 			}
+			jep_set_int(result, n);
 		}
 	}
 	else
@@ -2403,8 +1381,6 @@ jep_obj *jep_or(jep_ast_node node, jep_obj *list)
 		printf("could not obtain both operand values\n");
 	}
 
-	result->val = (void *)n;
-
 	/* free the memory of the operands */
 	if (l != NULL)
 	{
@@ -2418,70 +1394,51 @@ jep_obj *jep_or(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* performs a bitwise operation */
-jep_obj *jep_bitand(jep_ast_node node, jep_obj *list)
+/* performs a not operation */
+jep_obj *jep_not(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
-
-	if (node.leaf_count != 2)
+	if (node.leaf_count != 1)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	return jep_not_object(jep_evaluate(&(node.leaves[0]), list));
+}
 
-	/* operand type check */
-	if (!jep_otc("&", l) || !jep_otc("&", r))
+/* performs a not operation on an object */
+jep_obj *jep_not_object(jep_obj *l)
+{
+	jep_obj *result = NULL; /* result */
+
+	if (l != NULL && l->ret & JEP_EXCEPTION)
 	{
-		printf("invalid operand type for operator &\n");
+		return l;
 	}
 
-	if (l != NULL && r != NULL)
+	/* operand type check */
+	if (!jep_otc("!", l))
 	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
+		printf("invalid operand type for operator !\n");
+	}
 
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) & (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) & (*(long *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) & (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) & (*(char *)(r->val));
-		}
-		else if (l->type == JEP_INT)
-		{
-			if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) & (*(long *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) & (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) & (*(char *)(r->val));
-		}
-		else if (l->type == JEP_LONG)
-		{
-			if (r->type == JEP_INT)            *n = (*(long *)(l->val)) & (*(int *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) & (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) & (*(char *)(r->val));
-		}
-		else if (l->type == JEP_BYTE)
-		{
-			if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) & (*(int *)(r->val));
-			else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) & (*(long *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) & (*(char *)(r->val));
-		}
-		else if (l->type == JEP_CHARACTER)
-		{
-			if (r->type == JEP_INT)       *n = (*(char *)(l->val)) & (*(int *)(r->val));
-			else if (r->type == JEP_LONG) *n = (*(char *)(l->val)) & (*(long *)(r->val));
-			else if (r->type == JEP_BYTE) *n = (*(char *)(l->val)) & (*(unsigned char *)(r->val));
-		}
+	int n = 0;
+	result = jep_create_object();
+	result->type = JEP_INT;
+
+	if (l != NULL)
+	{
+		if (l->type == JEP_INT)            n = !(*(int *)(l->val));
+		else if (l->type == JEP_LONG)      n = !(*(long *)(l->val));
+		else if (l->type == JEP_DOUBLE)    n = !(*(double *)(l->val));
+		else if (l->type == JEP_BYTE)      n = !(*(unsigned char *)(l->val));
+		else if (l->type == JEP_CHARACTER) n = !(*(char *)(l->val));
+		else if (l->type == JEP_NULL)      n = 0;
 
-		result->val = (void *)n;
+		jep_set_int(result, n);
 	}
 	else
 	{
-		printf("could not obtain both operand values\n");
+		printf("could not obtain operand val\n");
 	}
 
 	/* free the memory of the operands */
@@ -2489,16 +1446,12 @@ jep_obj *jep_bitand(jep_ast_node node, jep_obj *list)
 	{
 		jep_destroy_object(l);
 	}
-	if (r != NULL)
-	{
-		jep_destroy_object(r);
-	}
 
 	return result;
 }
 
-/* performs a bitwise or operation */
-jep_obj *jep_bitor(jep_ast_node node, jep_obj *list)
+/* performs a logical and operation */
+jep_obj *jep_and(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *l = NULL;		/* left operand  */
 	jep_obj *r = NULL;		/* right operand */
@@ -2509,60 +1462,114 @@ jep_obj *jep_bitor(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
 
-	/* operand type check */
-	if (!jep_otc("|", l) || !jep_otc("|", r))
+	/* return if the left operand decides the result */
+	result = jep_and_left(l);
+	if (result != NULL)
 	{
-		printf("invalid operand type for operator |\n");
+		return result;
 	}
 
-	if (l != NULL && r != NULL)
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
+		return l;
+	}
 
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) | (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) | (*(long *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) | (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) | (*(char *)(r->val));
-		}
-		else if (l->type == JEP_INT)
-		{
-			if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) | (*(long *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) | (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) | (*(char *)(r->val));
-		}
-		else if (l->type == JEP_LONG)
-		{
-			if (r->type == JEP_INT)            *n = (*(long *)(l->val)) | (*(int *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) | (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) | (*(char *)(r->val));
-		}
-		else if (l->type == JEP_BYTE)
+	return jep_and_objects(l, r);
+}
+
+/* checks whether the left operand decides a logical and operation */
+jep_obj *jep_and_left(jep_obj *l)
+{
+	jep_obj *result = NULL; /* result */
+
+	/* a thrown left operand decides the result */
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		return l;
+	}
+
+	/* operand type check */
+	if (!jep_otc("&&", l))
+	{
+		printf("invalid operand type for operator &&\n");
+	}
+
+	int n = -1;
+
+	/* check result of left operand first */
+	if (l != NULL)
+	{
+		switch (l->type)
 		{
-			if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) | (*(int *)(r->val));
-			else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) | (*(long *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) | (*(char *)(r->val));
+		case JEP_INT:
+			if ((*(int *)(l->val)) == 0) n = 0;
+			break;
+		case JEP_LONG:
+			if ((*(long *)(l->val)) == 0) n = 0;
+			break;
+		case JEP_DOUBLE:
+			if ((*(double *)(l->val)) == 0) n = 0;
+			break;
+		case JEP_BYTE:
+			if ((*(unsigned char *)(l->val)) == 0) n = 0;
+			break;
+		case JEP_CHARACTER:
+			if ((*(char *)(l->val)) == 0) n = 0;
+			break;
+		case JEP_STRING:
+			if (strlen((char *)(l->val)) < 1) n = 0;
+			break;
+		case JEP_NULL:
+			n = 0;
+			break;
+		default:
+			break;
 		}
-		else if (l->type == JEP_CHARACTER)
+	}
+
+	/* return if the left operand decides the result */
+	if (n > -1)
+	{
+		result = jep_create_object();
+		result->type = JEP_INT;
+		jep_set_int(result, n);
+		jep_destroy_object(l);
+		return result;
+	}
+
+	return NULL;
+}
+
+/* performs a logical and operation on two objects */
+jep_obj *jep_and_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
+
+	int n = 0;
+	result = jep_create_object();
+	result->type = JEP_INT;
+
+	if (l != NULL && r != NULL)
+	{
+		/* operand type check */
+		if (!jep_otc("&&", r))
 		{
-			if (r->type == JEP_INT)       *n = (*(char *)(l->val)) | (*(int *)(r->val));
-			else if (r->type == JEP_LONG) *n = (*(char *)(l->val)) | (*(long *)(r->val));
-			else if (r->type == JEP_BYTE) *n = (*(char *)(l->val)) | (*(unsigned char *)(r->val));
+			printf("invalid operand type for operator &&\n");
 		}
 
-		result->val = (void *)n;
+		n = jep_truth(l) && jep_truth(r);
 	}
 	else
 	{
 		printf("could not obtain both operand values\n");
 	}
 
+	jep_set_int(result, n);
+
 	/* free the memory of the operands */
 	if (l != NULL)
 	{
@@ -2576,8 +1583,8 @@ jep_obj *jep_bitor(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* performs a bitwise xor operation */
-jep_obj *jep_bitxor(jep_ast_node node, jep_obj *list)
+/* performs a logical or operation */
+jep_obj *jep_or(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *l = NULL;		/* left operand  */
 	jep_obj *r = NULL;		/* right operand */
@@ -2588,60 +1595,111 @@ jep_obj *jep_bitxor(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+
+	/* return if the left operand decides the result */
+	result = jep_or_left(l);
+	if (result != NULL)
+	{
+		return result;
+	}
+
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
+	{
+		return l;
+	}
+
+	return jep_or_objects(l, r);
+}
+
+/* checks whether the left operand decides a logical or operation */
+jep_obj *jep_or_left(jep_obj *l)
+{
+	jep_obj *result = NULL; /* result */
+
+	/* a thrown left operand decides the result */
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		return l;
+	}
 
 	/* operand type check */
-	if (!jep_otc("^", l) || !jep_otc("^", r))
+	if (!jep_otc("||", l))
 	{
-		printf("invalid operand type for operator ^\n");
+		printf("invalid operand type for operator ||\n");
 	}
 
-	if (l != NULL && r != NULL)
+	int n = -1;
+
+	/* check result of left operand first */
+	if (l != NULL)
+	{
+		switch (l->type)
+		{
+		case JEP_INT:
+			if ((*(int *)(l->val)) != 0) n = 1;
+			break;
+		case JEP_LONG:
+			if ((*(long *)(l->val)) != 0) n = 1;
+			break;
+		case JEP_DOUBLE:
+			if ((*(double *)(l->val)) != 0) n = 1;
+			break;
+		case JEP_BYTE:
+			if ((*(unsigned char *)(l->val)) != 0) n = 1;
+			break;
+		case JEP_CHARACTER:
+			if ((*(char *)(l->val)) != 0) n = 1;
+			break;
+		case JEP_STRING:
+			if (strlen((char *)(l->val)) > 0) n = 1;
+			break;
+		default:
+			break;
+		}
+	}
+
+	/* return if the left operand decides the result */
+	if (n > -1)
 	{
-		int *n = malloc(sizeof(int));
 		result = jep_create_object();
 		result->type = JEP_INT;
+		jep_set_int(result, n);
+		jep_destroy_object(l);
+		return result;
+	}
 
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) ^ (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) ^ (*(long *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) ^ (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) ^ (*(char *)(r->val));
-		}
-		else if (l->type == JEP_INT)
-		{
-			if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) ^ (*(long *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) ^ (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) ^ (*(char *)(r->val));
-		}
-		else if (l->type == JEP_LONG)
-		{
-			if (r->type == JEP_INT)            *n = (*(long *)(l->val)) ^ (*(int *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) ^ (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) ^ (*(char *)(r->val));
-		}
-		else if (l->type == JEP_BYTE)
-		{
-			if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) ^ (*(int *)(r->val));
-			else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) ^ (*(long *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) ^ (*(char *)(r->val));
-		}
-		else if (l->type == JEP_CHARACTER)
+	return NULL;
+}
+
+/* performs a logical or operation on two objects */
+jep_obj *jep_or_objects(jep_obj *l, jep_obj *r)
+{
+	jep_obj *result = NULL; /* result */
+
+	int n = 0;
+	result = jep_create_object();
+	result->type = JEP_INT;
+
+	if (l != NULL && r != NULL)
+	{
+		/* operand type check */
+		if (!jep_otc("||", r))
 		{
-			if (r->type == JEP_INT)       *n = (*(char *)(l->val)) ^ (*(int *)(r->val));
-			else if (r->type == JEP_LONG) *n = (*(char *)(l->val)) ^ (*(long *)(r->val));
-			else if (r->type == JEP_BYTE) *n = (*(char *)(l->val)) ^ (*(unsigned char *)(r->val));
+			printf("invalid operand type for operator &&\n");
 		}
 
-		result->val = (void *)n;
+		n = jep_truth(l) || jep_truth(r);
 	}
 	else
 	{
 		printf("could not obtain both operand values\n");
 	}
 
+	jep_set_int(result, n);
+
 	/* free the memory of the operands */
 	if (l != NULL)
 	{
@@ -2655,162 +1713,151 @@ jep_obj *jep_bitxor(jep_ast_node node, jep_obj *list)
 	return result;
 }
 
-/* performs a left bit shift operation */
-jep_obj *jep_lshift(jep_ast_node node, jep_obj *list)
+/* performs a bitwise operation */
+jep_obj *jep_bitand(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc("<<", l) || !jep_otc("<<", r))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator <<\n");
+		return l;
 	}
 
-	if (l != NULL && r != NULL)
-	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
+	return jep_bitand_objects(l, r);
+}
 
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) << (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) << (*(long *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) << (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) << (*(char *)(r->val));
-		}
-		else if (l->type == JEP_INT)
-		{
-			if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) << (*(long *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) << (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) << (*(char *)(r->val));
-		}
-		else if (l->type == JEP_LONG)
-		{
-			if (r->type == JEP_INT)            *n = (*(long *)(l->val)) << (*(int *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) << (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) << (*(char *)(r->val));
-		}
-		else if (l->type == JEP_BYTE)
-		{
-			if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) << (*(int *)(r->val));
-			else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) << (*(long *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) << (*(char *)(r->val));
-		}
-		else if (l->type == JEP_CHARACTER)
-		{
-			if (r->type == JEP_INT)       *n = (*(char *)(l->val)) << (*(int *)(r->val));
-			else if (r->type == JEP_LONG) *n = (*(char *)(l->val)) << (*(long *)(r->val));
-			else if (r->type == JEP_BYTE) *n = (*(char *)(l->val)) << (*(unsigned char *)(r->val));
-		}
+/* performs a bitwise and operation on two objects */
+jep_obj *jep_bitand_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_bitwise(jep_bitand_kernels, "&", l, r);
+}
 
-		result->val = (void *)n;
-	}
-	else
-	{
-		printf("could not obtain both operand values\n");
-	}
+/* performs a bitwise or operation */
+jep_obj *jep_bitor(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	if (node.leaf_count != 2)
 	{
-		jep_destroy_object(l);
+		return NULL;
 	}
-	if (r != NULL)
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		jep_destroy_object(r);
+		return l;
 	}
 
-	return result;
+	return jep_bitor_objects(l, r);
 }
 
-/* performs a right bit shift operation */
-jep_obj *jep_rshift(jep_ast_node node, jep_obj *list)
+/* performs a bitwise or operation on two objects */
+jep_obj *jep_bitor_objects(jep_obj *l, jep_obj *r)
 {
-	jep_obj *l = NULL;		/* left operand  */
-	jep_obj *r = NULL;		/* right operand */
-	jep_obj *result = NULL; /* result        */
+	return jep_bitwise(jep_bitor_kernels, "|", l, r);
+}
+
+/* performs a bitwise xor operation */
+jep_obj *jep_bitxor(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
-	r = jep_evaluate(node.leaves[1], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
 
-	/* operand type check */
-	if (!jep_otc(">>", l) || !jep_otc(">>", r))
+	if (jep_thrown(&l, &r))
 	{
-		printf("invalid operand type for operator >>\n");
+		return l;
 	}
 
-	if (l != NULL && r != NULL)
-	{
-		int *n = malloc(sizeof(int));
-		result = jep_create_object();
-		result->type = JEP_INT;
+	return jep_bitxor_objects(l, r);
+}
 
-		if (l->type == r->type)
-		{
-			if (l->type == JEP_INT)            *n = (*(int *)(l->val)) >> (*(int *)(r->val));
-			else if (l->type == JEP_LONG)      *n = (*(long *)(l->val)) >> (*(long *)(r->val));
-			else if (l->type == JEP_BYTE)      *n = (*(unsigned char *)(l->val)) >> (*(unsigned char *)(r->val));
-			else if (l->type == JEP_CHARACTER) *n = (*(char *)(l->val)) >> (*(char *)(r->val));
-		}
-		else if (l->type == JEP_INT)
-		{
-			if (r->type == JEP_LONG)           *n = (*(int *)(l->val)) >> (*(long *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(int *)(l->val)) >> (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(int *)(l->val)) >> (*(char *)(r->val));
-		}
-		else if (l->type == JEP_LONG)
-		{
-			if (r->type == JEP_INT)            *n = (*(long *)(l->val)) >> (*(int *)(r->val));
-			else if (r->type == JEP_BYTE)      *n = (*(long *)(l->val)) >> (*(unsigned char *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(long *)(l->val)) >> (*(char *)(r->val));
-		}
-		else if (l->type == JEP_BYTE)
-		{
-			if (r->type == JEP_INT)            *n = (*(unsigned char *)(l->val)) >> (*(int *)(r->val));
-			else if (r->type == JEP_LONG)      *n = (*(unsigned char *)(l->val)) >> (*(long *)(r->val));
-			else if (r->type == JEP_CHARACTER) *n = (*(unsigned char *)(l->val)) >> (*(char *)(r->val));
-		}
-		else if (l->type == JEP_CHARACTER)
-		{
-			if (r->type == JEP_INT)       *n = (*(char *)(l->val)) >> (*(int *)(r->val));
-			else if (r->type == JEP_LONG) *n = (*(char *)(l->val)) >> (*(long *)(r->val));
-			else if (r->type == JEP_BYTE) *n = (*(char *)(l->val)) >> (*(unsigned char *)(r->val));
-		}
+/* performs a bitwise xor operation on two objects */
+jep_obj *jep_bitxor_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_bitwise(jep_bitxor_kernels, "^", l, r);
+}
+
+/* performs a left bit shift operation */
+jep_obj *jep_lshift(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
 
-		result->val = (void *)n;
+	if (node.leaf_count != 2)
+	{
+		return NULL;
 	}
-	else
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		printf("could not obtain both operand values\n");
+		return l;
 	}
 
-	/* free the memory of the operands */
-	if (l != NULL)
+	return jep_lshift_objects(l, r);
+}
+
+/* performs a left bit shift operation on two objects */
+jep_obj *jep_lshift_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_bitwise(jep_lshift_kernels, "<<", l, r);
+}
+
+/* performs a right bit shift operation */
+jep_obj *jep_rshift(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right operand */
+
+	if (node.leaf_count != 2)
 	{
-		jep_destroy_object(l);
+		return NULL;
 	}
-	if (r != NULL)
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	if (jep_thrown(&l, &r))
 	{
-		jep_destroy_object(r);
+		return l;
 	}
 
-	return result;
+	return jep_rshift_objects(l, r);
+}
+
+/* performs a right bit shift operation on two objects */
+jep_obj *jep_rshift_objects(jep_obj *l, jep_obj *r)
+{
+	return jep_bitwise(jep_rshift_kernels, ">>", l, r);
+}
+
+/* checks whether an object is an element of a buffer */
+static int jep_is_buffer_byte(jep_obj *o)
+{
+	return o->type == JEP_BYTE && o->self != NULL
+		&& o->self->type == JEP_BUFFER;
 }
 
 /* performs an increment on an integer */
@@ -2821,8 +1868,13 @@ jep_obj *jep_inc(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
+	return jep_inc_object(jep_evaluate(&(node.leaves[0]), list), node.token.postfix);
+}
+
+/* performs an increment on an object */
+jep_obj *jep_inc_object(jep_obj *obj, int postfix)
+{
 	jep_obj *o = NULL;
-	jep_obj *obj = jep_evaluate(node.leaves[0], list);
 
 	if (obj != NULL)
 	{
@@ -2835,13 +1887,24 @@ jep_obj *jep_inc(jep_ast_node node, jep_obj *list)
 		jep_obj *actual = obj->self;
 		o = jep_create_object();
 
+		if (jep_is_buffer_byte(obj))
+		{
+			unsigned char cur_byte = *(unsigned char *)(obj->val);
+			unsigned char new_byte = cur_byte + 1;
+			jep_set_buffer_byte(actual, obj->index, new_byte);
+			jep_set_byte(o, postfix ? cur_byte : new_byte);
+			o->type = JEP_BYTE;
+			jep_destroy_object(obj);
+			return o;
+		}
+
 		int cur_val = *(int *)(actual->val);
 		int new_val = cur_val + 1;
 		*(int *)(actual->val) = new_val;
 
 		jep_copy_object(o, actual);
 
-		if (node.token.postfix)
+		if (postfix)
 		{
 			*(int *)(o->val) = cur_val;
 		}
@@ -2860,8 +1923,13 @@ jep_obj *jep_dec(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
+	return jep_dec_object(jep_evaluate(&(node.leaves[0]), list), node.token.postfix);
+}
+
+/* performs an decrement on an object */
+jep_obj *jep_dec_object(jep_obj *obj, int postfix)
+{
 	jep_obj *o = NULL;
-	jep_obj *obj = jep_evaluate(node.leaves[0], list);
 
 	if (obj != NULL)
 	{
@@ -2874,13 +1942,24 @@ jep_obj *jep_dec(jep_ast_node node, jep_obj *list)
 		jep_obj *actual = obj->self;
 		o = jep_create_object();
 
+		if (jep_is_buffer_byte(obj))
+		{
+			unsigned char cur_byte = *(unsigned char *)(obj->val);
+			unsigned char new_byte = cur_byte - 1;
+			jep_set_buffer_byte(actual, obj->index, new_byte);
+			jep_set_byte(o, postfix ? cur_byte : new_byte);
+			o->type = JEP_BYTE;
+			jep_destroy_object(obj);
+			return o;
+		}
+
 		int cur_val = *(int *)(actual->val);
 		int new_val = cur_val - 1;
 		*(int *)(actual->val) = new_val;
 
 		jep_copy_object(o, actual);
 
-		if (node.token.postfix)
+		if (postfix)
 		{
 			*(int *)(o->val) = cur_val;
 		}
@@ -2894,19 +1973,80 @@ jep_obj *jep_dec(jep_ast_node node, jep_obj *list)
 /* performs an addition assignmnet */
 jep_obj *jep_add_assign(jep_ast_node node, jep_obj *list)
 {
-	jep_token equals = { NULL, 0, T_EQUALS, 0, 0, 0, 0, NULL };
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right oeprand */
+
+	if (node.leaf_count != 2)
+	{
+		return NULL;
+	}
+
+	l = jep_evaluate(&(node.leaves[0]), list);
+
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		return l;
+	}
+
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	return jep_add_assign_objects(l, r, &(node.leaves[0]), list);
+}
+
+/* adds an object to another and assigns the sum to it */
+jep_obj *jep_add_assign_objects(jep_obj *l, jep_obj *r, jep_ast_node *target, jep_obj *list)
+{
+	jep_obj *o = NULL; /* the recipient of the assignment */
+	jep_obj *v = NULL; /* the value of the left operand   */
+
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		jep_destroy_object(r);
+		return l;
+	}
+
+	if (r != NULL && r->ret & JEP_EXCEPTION)
+	{
+		jep_destroy_object(l);
+		return r;
+	}
+
+	if (l != NULL && r != NULL && l->type == JEP_STRING)
+	{
+		o = l->self;
+	}
+
+	/*
+	 * a string that is only used by its object and the left operand
+	 * can have the characters of the right operand appended in place
+	 */
+	if (o != NULL && o != l && o->val == l->val && !(o->mod & 2)
+		&& jep_string_refs(o) == 2)
+	{
+		char *r_str = jep_to_string(r);
 
-	jep_token operator ={ NULL, 0, T_PLUS, 0, 0, 0, 0, NULL };
+		jep_destroy_object(l);
 
-	jep_ast_node operands[] = { node.leaves[0], node.leaves[1] };
+		if (r_str != NULL)
+		{
+			jep_append_chars(o, r_str);
+			free(r_str);
+		}
 
-	jep_ast_node operation = { operator, 2, 0, operands, 0, 0, 0, 0 };
+		jep_destroy_object(r);
 
-	jep_ast_node asign_operands[] = { node.leaves[0], operation };
+		v = jep_create_object();
+		jep_copy_object(v, o);
+		return v;
+	}
 
-	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
+	if (l != NULL)
+	{
+		v = jep_create_object();
+		jep_copy_object(v, l);
+	}
 
-	return jep_evaluate(assignment, list);
+	return jep_assign_objects(l, jep_add_objects(v, r), target, list);
 }
 
 /* performs a subtraction assignment */
@@ -2924,7 +2064,7 @@ jep_obj *jep_sub_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a multiplication assignment */
@@ -2942,7 +2082,7 @@ jep_obj *jep_mul_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a division assignment */
@@ -2960,7 +2100,7 @@ jep_obj *jep_div_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a modulus assignment */
@@ -2978,7 +2118,7 @@ jep_obj *jep_mod_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a bitwise and assignment on an integer */
@@ -2996,7 +2136,7 @@ jep_obj *jep_and_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a bitwise and assignment on an integer */
@@ -3014,7 +2154,7 @@ jep_obj *jep_or_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a bitwise exclusive or assignment on an integer */
@@ -3032,7 +2172,7 @@ jep_obj *jep_xor_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a bitwise exclusive or assignment on an integer */
@@ -3050,7 +2190,7 @@ jep_obj *jep_lshift_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* performs a bitwise exclusive or assignment on an integer */
@@ -3068,29 +2208,81 @@ jep_obj *jep_rshift_assign(jep_ast_node node, jep_obj *list)
 
 	jep_ast_node assignment = { equals, 2, 0, asign_operands, 0, 0, 0, 0 };
 
-	return jep_evaluate(assignment, list);
+	return jep_evaluate(&assignment, list);
 }
 
 /* evaluates an assignment */
 jep_obj *jep_assign(jep_ast_node node, jep_obj *list)
 {
-	jep_obj *o = NULL; /* the recipient of the assignment */
-	jep_obj *l = NULL; /* left operand                    */
-	jep_obj *r = NULL; /* right oeprand                   */
+	jep_obj *l = NULL; /* left operand  */
+	jep_obj *r = NULL; /* right oeprand */
 
 	if (node.leaf_count != 2)
 	{
 		return NULL;
 	}
 
-	l = jep_evaluate(node.leaves[0], list);
+	l = jep_evaluate(&(node.leaves[0]), list);
 
 	if (l != NULL && l->ret & JEP_EXCEPTION)
 	{
 		return l;
 	}
 
-	r = jep_evaluate(node.leaves[1], list);
+	r = jep_evaluate(&(node.leaves[1]), list);
+
+	return jep_assign_objects(l, r, &(node.leaves[0]), list);
+}
+
+/* assigns a value to an element of a buffer */
+static jep_obj *jep_assign_buffer_byte(jep_obj *l, jep_obj *r)
+{
+	jep_obj *buffer = l->self;
+
+	if (buffer->mod & 2)
+	{
+		printf("error: cannot reassign a constant\n");
+		jep_destroy_object(l);
+		jep_destroy_object(r);
+		return NULL;
+	}
+
+	if (r == NULL)
+	{
+		printf("invalid type for an element of a buffer\n");
+	}
+	else if (r->type == JEP_INT)
+	{
+		jep_set_buffer_byte(buffer, l->index, *(int *)(r->val) & UCHAR_MAX);
+	}
+	else if (r->type == JEP_LONG)
+	{
+		jep_set_buffer_byte(buffer, l->index, *(long *)(r->val) & UCHAR_MAX);
+	}
+	else if (r->type == JEP_BYTE || r->type == JEP_CHARACTER)
+	{
+		jep_set_buffer_byte(buffer, l->index, *(unsigned char *)(r->val));
+	}
+	else
+	{
+		printf("invalid type for an element of a buffer\n");
+	}
+
+	jep_destroy_object(l);
+
+	return r;
+}
+
+/* assigns one object to another */
+jep_obj *jep_assign_objects(jep_obj *l, jep_obj *r, jep_ast_node *target, jep_obj *list)
+{
+	jep_obj *o = NULL; /* the recipient of the assignment */
+
+	if (l != NULL && l->ret & JEP_EXCEPTION)
+	{
+		jep_destroy_object(r);
+		return l;
+	}
 
 	if (r != NULL && r->ret & JEP_EXCEPTION)
 	{
@@ -3101,11 +2293,16 @@ jep_obj *jep_assign(jep_ast_node node, jep_obj *list)
 		return r;
 	}
 
-	if (l != NULL || node.leaves[0].token.type == T_IDENTIFIER)
+	if (l != NULL && jep_is_buffer_byte(l))
+	{
+		return jep_assign_buffer_byte(l, r);
+	}
+
+	if (l != NULL || target->token.type == T_IDENTIFIER)
 	{
 		if (l == NULL)
 		{
-			o = jep_get_object(node.leaves[0].token.val->buffer, list);
+			o = jep_lookup(target, list);
 		}
 		else
 		{
@@ -3117,7 +2314,7 @@ jep_obj *jep_assign(jep_ast_node node, jep_obj *list)
 		{
 			/* create the object if it doesn't exist */
 			o = jep_create_object();
-			o->ident = node.leaves[0].token.val->buffer;
+			o->ident = target->token.val->buffer;
 			jep_add_object(list, o);
 		}
 		else if (o->mod & 2)
@@ -3136,9 +2333,25 @@ jep_obj *jep_assign(jep_ast_node node, jep_obj *list)
 			return NULL;
 		}
 
-		jep_copy_object(o, r);
+		if (target->token.type == T_IDENTIFIER && target->loop & JEP_DISCARDED)
+		{
+			/* nothing uses the value of the assignment, so r is moved */
+			jep_move_object(o, r);
+		}
+		else if (target->token.type == T_IDENTIFIER)
+		{
+			jep_copy_object(o, r);
+		}
+		else
+		{
+			/*
+			 * an element or member can't share its lists, since the value
+			 * could contain the array or struct that is being assigned to
+			 */
+			jep_clone_object(o, r);
+		}
 
-		if (r->type == JEP_ARRAY)
+		if (o->type == JEP_ARRAY)
 		{
 			int i = 0;
 			jep_obj *head = ((jep_obj *)(o->val))->head;
@@ -3161,6 +2374,41 @@ jep_obj *jep_assign(jep_ast_node node, jep_obj *list)
 	return r;
 }
 
+/*
+ * evaluates the arguments of a function call.
+ * the evaluated objects are temporaries, so they are moved into the
+ * argument list instead of being copied.
+ */
+static jep_obj *jep_arguments(jep_ast_node node, jep_obj *list)
+{
+	jep_obj *arg_list = NULL;
+
+	/* collect the function arguments as objects */
+	if (node.leaf_count == 2)
+	{
+		arg_list = jep_create_object();
+		arg_list->type = JEP_LIST;
+		if (node.leaves[0].token.token_code == T_COMMA)
+		{
+			jep_sequence(node.leaves[0], list, arg_list);
+		}
+		else
+		{
+			jep_obj *a = jep_evaluate(&(node.leaves[0]), list);
+			if (a != NULL)
+			{
+				jep_add_object(arg_list, a);
+			}
+			else
+			{
+				printf("could not evaluate argument\n");
+			}
+		}
+	}
+
+	return arg_list;
+}
+
 /* evaluates the contents of a set of parentheses */
 jep_obj *jep_paren(jep_ast_node node, jep_obj *list)
 {
@@ -3168,7 +2416,7 @@ jep_obj *jep_paren(jep_ast_node node, jep_obj *list)
 	{
 		if (node.leaf_count == 1)
 		{
-			return jep_evaluate(node.leaves[0], list);
+			return jep_evaluate(&(node.leaves[0]), list);
 		}
 		else
 		{
@@ -3176,8 +2424,6 @@ jep_obj *jep_paren(jep_ast_node node, jep_obj *list)
 		}
 	}
 
-	jep_obj *o;		   /* function return value    */
-	jep_ast_node args; /* incoming arguments       */
 	jep_obj *func;	   /* function being called    */
 	jep_obj *arg_list; /* list of argument objects */
 
@@ -3186,163 +2432,320 @@ jep_obj *jep_paren(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
-	o = NULL;
-	func = NULL;
-	arg_list = NULL;
+	func = jep_lookup(&(node.leaves[node.leaf_count - 1]), list);
+	arg_list = jep_arguments(node, list);
 
-	/* collect the function arguments as objects */
-	if (node.leaf_count == 2)
+	if (func == NULL)
 	{
-		func = jep_get_object(node.leaves[1].token.val->buffer, list);
-		args = node.leaves[0];
-		arg_list = jep_create_object();
-		arg_list->type = JEP_LIST;
-		if (args.leaf_count >= 1)
+		printf("couldn't find a function with the specified identifer\n");
+		jep_destroy_object(arg_list);
+		return NULL;
+	}
+
+	return jep_call(func, arg_list, list);
+}
+
+/* evaluates the body of a function */
+static jep_obj *jep_evaluate_body(jep_ast_node *body, jep_obj *list)
+{
+	if (body->code != NULL)
+	{
+		return jep_execute(body->code, list);
+	}
+
+	return jep_evaluate(body, list);
+}
+
+/* adds the slots and the scope of a call to a function's body */
+void jep_enter_frame(jep_frame *frame, jep_ast_node *body, jep_obj *arg_list,
+	jep_obj *list)
+{
+	jep_env *env = (jep_env *)(list->val);
+	jep_obj *arg = arg_list->head;
+	int i;
+
+	frame->size = body->slots;
+	frame->slots = frame->size > 0
+		? jep_pool_alloc(frame->size * sizeof(jep_obj *)) : NULL;
+	frame->parent = env != NULL ? env->frame : NULL;
+	frame->body = body->leaves;
+
+	/* the arguments occupy the first slots */
+	for (i = 0; i < frame->size; i++)
+	{
+		frame->slots[i] = arg;
+		if (arg != NULL)
 		{
-			if (node.leaves[0].token.token_code == T_COMMA)
-			{
-				jep_obj* objects = jep_create_object();
-				objects->type = JEP_LIST;
-				jep_sequence(node.leaves[0], list, objects);
-				jep_copy_object(arg_list, objects);
-				jep_destroy_object(objects);
-			}
-			else
-			{
-				jep_obj *a = jep_evaluate(node.leaves[0], list);
-				if (a != NULL)
-				{
-					jep_obj* local_a = jep_create_object();
-					jep_copy_object(local_a, a);
-					jep_destroy_object(a);
-					/* jep_destroy_object removes the excess reference
-					if (a->type == JEP_FILE && a->val != NULL)
-					{
-						jep_file *file_obj = (jep_file *)(a->val);
-						(file_obj->refs)--;
-					}
-					*/
-					jep_add_object(arg_list, local_a);
-				}
-				else
-				{
-					printf("could not evaluate argument\n");
-				}
-			}
+			arg = arg->next;
 		}
-		else if (args.leaf_count == 0)
-		{
-			jep_obj *a = jep_evaluate(node.leaves[0], list);
+	}
 
-			if (a != NULL)
-			{
-				jep_obj* local_a = jep_create_object();
-				jep_copy_object(local_a, a);
-				jep_destroy_object(a);
-				/* jep_destroy_object removes the excess reference
-				if (a->type == JEP_FILE && a->val != NULL)
-				{
-					jep_file *file_obj = (jep_file *)(a->val);
-					(file_obj->refs)--;
-				}
-				*/
-				jep_add_object(arg_list, local_a);
-			}
-			else
-			{
-				printf("could not evaluate argument\n");
-			}
-		}
+	jep_add_object(list, arg_list);
+	if (env != NULL)
+	{
+		env->frame = frame;
 	}
-	else if (node.leaf_count == 1)
+}
+
+/* removes the slots and the scope of a call */
+void jep_leave_frame(jep_frame *frame, jep_obj *list)
+{
+	jep_env *env = (jep_env *)(list->val);
+
+	/* remove the argument list from the main list */
+	if (env != NULL)
 	{
-		func = jep_get_object(node.leaves[0].token.val->buffer, list);
+		env->frame = frame->parent;
 	}
+	jep_remove_scope(list);
 
-	if (func != NULL)
+	if (frame->slots != NULL)
 	{
-		jep_obj *fargs = func->head;
-		jep_obj *farg = NULL;
+		jep_pool_free(frame->slots, frame->size * sizeof(jep_obj *));
+	}
+}
 
-		if (fargs != NULL)
-		{
-			farg = fargs->head;
-		}
+/*
+ * evaluates the body of a function in a new frame.
+ * the slots come from the pool, so every nested call only adds the
+ * frame itself to the C stack.
+ */
+static jep_obj *jep_evaluate_frame(jep_ast_node *body, jep_obj *arg_list,
+	jep_obj *list)
+{
+	jep_obj *o = NULL;
+	jep_frame frame;
 
-		/* native function call */
-		if (func->size == 1)
-		{
-			jep_obj* l_native = jep_get_object(" SwapNative", list);
+	jep_enter_frame(&frame, body, arg_list, list);
+	o = jep_evaluate_body(body, list);
+	jep_leave_frame(&frame, list);
+
+	return o;
+}
 
-			jep_obj* native_result = jep_call_shared((jep_lib)(l_native->val), func->ident, arg_list, list);
+/*
+ * detaches moved arguments from the objects they were evaluated from,
+ * so assigning to an argument doesn't change the caller's variable
+ */
+static void jep_own_arguments(jep_obj *arg_list)
+{
+	jep_obj *arg = arg_list != NULL ? arg_list->head : NULL;
 
-			if (arg_list != NULL)
-			{
-				jep_destroy_object(arg_list);
-			}
+	while (arg != NULL)
+	{
+		arg->ident = NULL;
+		arg->self = arg;
+		arg->index = -1;
+		arg->array_ident = NULL;
+		arg->mod = 0;
+		arg = arg->next;
+	}
+}
+
+/*
+ * gives the arguments of a call the names of the function's parameters,
+ * returning 0 if the numbers of arguments and parameters differ
+ */
+int jep_bind_arguments(jep_obj *func, jep_obj *arg_list)
+{
+	jep_obj *farg = func->head != NULL ? func->head->head : NULL;
+	jep_obj *arg = arg_list != NULL ? arg_list->head : NULL;
+
+	jep_own_arguments(arg_list);
+
+	while (arg != NULL && farg != NULL)
+	{
+		arg->ident = farg->ident;
+		farg = farg->next;
+		arg = arg->next;
+	}
+
+	return arg == NULL && farg == NULL;
+}
+
+/* creates an exception with a message */
+jep_obj *jep_exception(const char *message)
+{
+	jep_obj *e = jep_create_object();
+	e->type = JEP_STRING;
+	e->ret = JEP_RETURN | JEP_EXCEPTION;
+	e->val = malloc(strlen(message) + 1);
+	strcpy(e->val, message);
+	return e;
+}
+
+/*
+ * checks whether the calls in progress have used the C stack that
+ * nested calls are allowed, measured from where evaluation started
+ */
+static int jep_stack_exhausted(jep_env *env)
+{
+	char here;
+	size_t used;
+
+	if (env->stack_base == NULL)
+	{
+		return 0;
+	}
+
+	used = env->stack_base > &here
+		? (size_t)(env->stack_base - &here) : (size_t)(&here - env->stack_base);
+
+	return used > env->stack_size;
+}
+
+/*
+ * calls a function with a list of arguments.
+ * a tail call of the function returns its arguments instead of calling
+ * it again, so the next call reuses the C stack of this one.
+ */
+jep_obj *jep_call(jep_obj *func, jep_obj *arg_list, jep_obj *list)
+{
+	jep_obj *o = NULL; /* function return value */
+	jep_env *env = (jep_env *)(list->val);
+
+	/* native function call */
+	if (func->size == 1)
+	{
+		jep_obj *native_result = NULL;
+
+		jep_own_arguments(arg_list);
 
-			return native_result;
+		if (func->imm.f != NULL)
+		{
+			native_result = ((jep_func)(func->imm.f))(arg_list, list);
+		}
+		else
+		{
+			printf("could not load function jep_%s from shared library\n", func->ident);
 		}
 
-		jep_ast_node body = *((jep_ast_node *)(func->head->next->val));
 		if (arg_list != NULL)
 		{
-			jep_obj *arg = arg_list->head;
-			while (arg != NULL && farg != NULL)
-			{
-				arg->ident = farg->ident;
-				farg = farg->next;
-				arg = arg->next;
-			}
-			if (arg != NULL || farg != NULL)
-			{
-				printf("woops, apparently there weren't the right amount of arguments!\n");
-			}
-			else
-			{
-				jep_add_object(list, arg_list);
+			jep_destroy_object(arg_list);
+		}
+
+		return native_result;
+	}
 
-				o = jep_evaluate(body, list);
+	if (env != NULL && (env->depth >= env->max_depth || jep_stack_exhausted(env)))
+	{
+		jep_destroy_object(arg_list);
+		return jep_exception("maximum call depth exceeded");
+	}
 
-				/* remove the argument list from the main list */
-				jep_remove_scope(list);
-			}
+	jep_ast_node *body = (jep_ast_node *)(func->head->next->val);
+
+	if (env != NULL)
+	{
+		env->depth++;
+	}
+
+	do
+	{
+		o = NULL;
+		if (!jep_bind_arguments(func, arg_list))
+		{
+			printf("woops, apparently there weren't the right amount of arguments!\n");
 		}
 		else
 		{
-			if (farg != NULL)
-			{
-				printf("woops, apparently there weren't the right amount of arguments!\n");
-			}
-			else
+			if (arg_list == NULL)
 			{
 				arg_list = jep_create_object();
 				arg_list->type = JEP_LIST;
+			}
+			o = jep_evaluate_frame(body, arg_list, list);
+		}
 
-				jep_add_object(list, arg_list);
-
-				o = jep_evaluate(body, list);
+		jep_destroy_object(arg_list);
 
-				/* remove the argument list from the main list */
-				jep_remove_scope(list);
-			}
+		/* the function returned a call to itself */
+		arg_list = NULL;
+		if (o != NULL && o->ret & JEP_TAIL_CALL)
+		{
+			arg_list = o;
+			arg_list->ret = 0;
 		}
+	} while (arg_list != NULL);
+
+	if (env != NULL)
+	{
+		env->depth--;
 	}
-	else
+
+	if (o != NULL && o->ret & JEP_RETURN)
 	{
-		printf("couldn't find a function with the specified identifer\n");
+		/*
+		 * mark a returned object as returned
+		 * so it doesn't returned recursively
+		 */
+		o->ret |= JEP_RETURNED;
 	}
 
-	jep_destroy_object(arg_list);
+	return o;
+}
 
-	if (o != NULL && o->ret & JEP_RETURN)
+/*
+ * calls a function from a return statement. a call to the function
+ * being returned from gives back its arguments for jep_call to make
+ * the call once the current one has ended.
+ */
+jep_obj *jep_tail_call(jep_obj *func, jep_obj *arg_list, jep_obj *list)
+{
+	jep_env *env = (jep_env *)(list->val);
+
+	if (func->size == 2 && env != NULL && env->frame != NULL
+		&& ((jep_ast_node *)(func->head->next->val))->leaves
+			== env->frame->body)
+	{
+		if (arg_list == NULL)
+		{
+			arg_list = jep_create_object();
+			arg_list->type = JEP_LIST;
+		}
+		arg_list->ret = JEP_RETURN | JEP_TAIL_CALL;
+		return arg_list;
+	}
+
+	return jep_call(func, arg_list, list);
+}
+
+/*
+ * creates an array from the elements in curly braces.
+ * it is kept out of jep_brace so that the blocks of nested statements
+ * don't reserve stack space for the elements.
+ */
+jep_obj *jep_array_literal(jep_ast_node *node, jep_obj *list)
+{
+	jep_obj *array = jep_create_object();
+	jep_obj *o = jep_create_object();
+
+	array->type = JEP_LIST;
+	o->type = JEP_ARRAY;
+	o->val = array;
+	if (node->leaf_count > 0 && node->leaves[0].token.token_code == T_COMMA)
+	{
+		jep_sequence(node->leaves[0], list, array);
+		int i = 0;
+		jep_obj *elem = array->head;
+		while (elem != NULL)
+		{
+			elem->index = i++;
+			elem->ident = NULL;
+			elem->self = elem;
+			elem = elem->next;
+		}
+	}
+	else if (node->leaf_count == 1)
 	{
-		/*
-		 * mark a returned object as returned
-		 * so it doesn't returned recursively
-		 */
-		o->ret |= JEP_RETURNED;
+		jep_obj *e = jep_evaluate(&(node->leaves[0]), list);
+		e->index = 0;
+		e->ident = NULL;
+		e->self = e;
+		jep_add_object(array, e);
 	}
+	o->size = array->size;
 
 	return o;
 }
@@ -3353,36 +2756,14 @@ jep_obj *jep_brace(jep_ast_node node, jep_obj *list)
 	jep_obj *o = NULL;
 	if (node.array)
 	{
-		jep_obj *array = jep_create_object();
-		array->type = JEP_LIST;
-		o = jep_create_object();
-		o->type = JEP_ARRAY;
-		o->val = array;
-		if (node.leaf_count > 0 && node.leaves[0].token.token_code == T_COMMA)
-		{
-			jep_sequence(node.leaves[0], list, array);
-			int i = 0;
-			jep_obj *elem = array->head;
-			while (elem != NULL)
-			{
-				elem->index = i++;
-				elem = elem->next;
-			}
-		}
-		else if (node.leaf_count == 1)
-		{
-			jep_obj *e = jep_evaluate(node.leaves[0], list);
-			e->index = 0;
-			jep_add_object(array, e);
-		}
-		o->size = array->size;
+		o = jep_array_literal(&node, list);
 	}
 	else
 	{
 		int i;
 		for (i = 0; i < node.leaf_count; i++)
 		{
-			o = jep_evaluate(node.leaves[i], list);
+			o = jep_evaluate(&(node.leaves[i]), list);
 			if (o != NULL && o->ret)
 			{
 				if (o->ret & JEP_EXCEPTION || !(o->ret & JEP_RETURNED))
@@ -3405,8 +2786,6 @@ jep_obj *jep_brace(jep_ast_node node, jep_obj *list)
 /* evaluates an array subscript */
 jep_obj *jep_subscript(jep_ast_node node, jep_obj *list)
 {
-
-	jep_obj *o = NULL;
 	if (node.leaf_count != 2 && node.leaf_count != 1)
 	{
 		printf("invalid leaf count for ast node\n");
@@ -3415,54 +2794,84 @@ jep_obj *jep_subscript(jep_ast_node node, jep_obj *list)
 	/* array initialization */
 	if (node.leaf_count == 1)
 	{
-		o = jep_create_object();
-		o->type = JEP_ARRAY;
-		jep_obj *array = jep_create_object();
-		array->type = JEP_LIST;
-		o->val = array;
+		return jep_sized_array(jep_evaluate(&(node.leaves[0]), list));
+	}
 
-		jep_obj *size = jep_evaluate(node.leaves[0], list);
+	/* array index access */
 
-		if (size == NULL || size->type != JEP_INT || size->val == NULL)
-		{
-			if (size != NULL)
-			{
-				jep_destroy_object(size);
-			}
-			printf("invalid array size\n");
-			jep_destroy_object(o);
-			jep_destroy_object(array);
-			o = NULL;
-			return o;
-		}
+	jep_obj *index = jep_evaluate(&(node.leaves[0]), list);
+	jep_obj *array = jep_evaluate(&(node.leaves[1]), list);
 
-		int s = *((int *)(size->val));
+	/* an element that is assigned to can't be shared with other arrays */
+	if (node.target)
+	{
+		jep_unshare(array);
+	}
 
-		jep_destroy_object(size);
+	return jep_subscript_objects(index, array);
+}
 
-		int i;
-		for (i = 0; i < s; i++)
+/* creates an array of a certain size */
+jep_obj *jep_sized_array(jep_obj *size)
+{
+	jep_obj *o = NULL;
+
+	if (size == NULL || size->type != JEP_INT || size->val == NULL)
+	{
+		if (size != NULL)
 		{
-			jep_obj *elem = jep_create_object();
-			elem->type = JEP_NULL;
-			elem->index = i;
-			jep_add_object(array, elem);
+			jep_destroy_object(size);
 		}
+		printf("invalid array size\n");
+		return o;
+	}
 
-		o->size = array->size;
+	o = jep_create_object();
+	o->type = JEP_ARRAY;
+	jep_obj *array = jep_create_object();
+	array->type = JEP_LIST;
+	o->val = array;
 
-		return o;
+	int s = *((int *)(size->val));
+
+	jep_destroy_object(size);
+
+	int i;
+	for (i = 0; i < s; i++)
+	{
+		jep_obj *elem = jep_create_object();
+		elem->type = JEP_NULL;
+		elem->index = i;
+		jep_add_object(array, elem);
 	}
 
-	/* array index access */
+	o->size = array->size;
+
+	return o;
+}
+
+/* creates the exception for an index outside of an array */
+static jep_obj *jep_bounds_exception()
+{
+	jep_obj *o = jep_create_object();
+	o->type = JEP_STRING;
+	o->ret = JEP_RETURN | JEP_EXCEPTION;
+	o->val = malloc(26);
+	strcpy(o->val, "array index out of bounds");
+	((char*)(o->val))[25] = '\0';
+	return o;
+}
 
-	jep_obj *index = jep_evaluate(node.leaves[0], list);
-	jep_obj *array = jep_evaluate(node.leaves[1], list);
+/* accesses an element of an array */
+jep_obj *jep_subscript_objects(jep_obj *index, jep_obj *array)
+{
+	jep_obj *o = NULL;
 
 	if (index != NULL && array != NULL)
 	{
 		if (index->ret & JEP_EXCEPTION)
 		{
+			jep_destroy_object(array);
 			return index;
 		}
 
@@ -3476,6 +2885,29 @@ jep_obj *jep_subscript(jep_ast_node node, jep_obj *list)
 		{
 			printf("array subscript must be an integer\n");
 		}
+		else if (array->type == JEP_BUFFER)
+		{
+			int i = *(int *)(index->val);
+			if (i < 0 || i >= jep_buffer_size(array))
+			{
+				jep_destroy_object(index);
+				jep_destroy_object(array);
+				return jep_bounds_exception();
+			}
+
+			/*
+			 * the bytes of a buffer are not objects, so an assignment
+			 * to the element writes through the buffer at its index
+			 */
+			o = jep_create_object();
+			o->type = JEP_BYTE;
+			jep_set_byte(o, jep_buffer_bytes(array)[i]);
+			o->index = i;
+			if (array->self != array)
+			{
+				o->self = array->self;
+			}
+		}
 		else if (array->type != JEP_ARRAY)
 		{
 			printf("cannot access index of non array object: ");
@@ -3484,34 +2916,20 @@ jep_obj *jep_subscript(jep_ast_node node, jep_obj *list)
 		else if (array->size > 0)
 		{
 			jep_obj *contents = (jep_obj *)(array->val);
-			jep_obj *elem = contents->head;
-			int target = *(int *)(index->val);
-			int i;
-			int found = 0;
-			for (i = 0; elem != NULL && !found; i++)
+			jep_obj *elem = jep_get_element(contents, *(int *)(index->val));
+			if (elem != NULL)
 			{
-				if (i == target)
-				{
-					o = jep_create_object();
-					jep_copy_object(o, elem);
-					o->array_ident = elem->array_ident;
-					o->index = elem->index;
-					jep_copy_self(o, elem);
-					found = 1;
-				}
-				elem = elem->next;
+				o = jep_create_object();
+				jep_copy_object(o, elem);
+				o->array_ident = elem->array_ident;
+				o->index = elem->index;
+				jep_copy_self(o, elem);
 			}
 			if (o == NULL)
 			{
 				jep_destroy_object(index);
 				jep_destroy_object(array);
-				o = jep_create_object();
-				o->type = JEP_STRING;
-				o->ret = JEP_RETURN | JEP_EXCEPTION;
-				o->val = malloc(26);
-				strcpy(o->val, "array index out of bounds");
-				((char*)(o->val))[25] = '\0';
-				return o;
+				return jep_bounds_exception();
 			}
 		}
 		else
@@ -3530,6 +2948,46 @@ jep_obj *jep_subscript(jep_ast_node node, jep_obj *list)
 	return o;
 }
 
+/*
+ * finds a data member of a struct.
+ * the access site remembers the slot of the member in the shape of the
+ * last struct it saw, so structs with the same shape are indexed
+ * directly instead of searching their members by identifier.
+ */
+static jep_obj *jep_find_member(jep_obj *struc, jep_ast_node *name)
+{
+	jep_obj *members = (jep_obj *)(struc->val);
+	const char *ident = name->token.val->buffer;
+	jep_obj *m;
+	int slot = 0;
+
+	if (struc->shape != NULL && name->shape == struc->shape)
+	{
+		m = jep_get_element(members, name->member);
+
+		/* an instance initialized with fewer values has fewer members */
+		if (m != NULL && m->ident == ident)
+		{
+			return m;
+		}
+	}
+
+	m = members->head;
+	while (m != NULL && m->ident != ident)
+	{
+		m = m->next;
+		slot++;
+	}
+
+	if (m != NULL && struc->shape != NULL)
+	{
+		name->shape = struc->shape;
+		name->member = slot;
+	}
+
+	return m;
+}
+
 jep_obj *jep_get_data_member(jep_ast_node node, jep_obj *list)
 {
 	if (node.leaf_count != 2)
@@ -3551,7 +3009,7 @@ jep_obj *jep_get_data_member(jep_ast_node node, jep_obj *list)
 	}
 	else if (node.leaves[0].token.token_code == T_DOUBLECOLON)
 	{
-		struc = jep_evaluate(node.leaves[0], list);
+		struc = jep_evaluate(&(node.leaves[0]), list);
 		if (struc != NULL)
 		{
 			jep_obj *tmp = struc;
@@ -3606,15 +3064,7 @@ jep_obj *jep_get_data_member(jep_ast_node node, jep_obj *list)
 
 	if (members->size > 0)
 	{
-		jep_obj *m = members->head;
-		while (m != NULL && mem == NULL)
-		{
-			if (!strcmp(m->ident, node.leaves[1].token.val->buffer))
-			{
-				mem = m;
-			}
-			m = m->next;
-		}
+		mem = jep_find_member(struc, &(node.leaves[1]));
 		if (mem == NULL)
 		{
 			printf("%s does not have a member with the identifier %s\n",
@@ -3681,6 +3131,13 @@ jep_obj *jep_function(jep_ast_node node, jep_obj *list)
 		body->val = n;
 		jep_add_object(func, body);
 	}
+	else
+	{
+		/* resolve the native implementation once */
+		jep_obj *l_native = jep_get_global(" SwapNative", list);
+		jep_lib lib = l_native != NULL ? (jep_lib)(l_native->val) : NULL;
+		func->imm.f = jep_get_native(lib, func->ident);
+	}
 
 	func->head->type = JEP_LIST;
 
@@ -3696,9 +3153,28 @@ jep_obj *jep_return(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 
-	if (node.leaf_count == 1)
+	if (node.leaf_count == 1 && node.loop & JEP_TAIL)
 	{
-		o = jep_evaluate(node.leaves[0], list);
+		jep_ast_node *call = &(node.leaves[0]);
+		jep_obj *func = jep_lookup(&(call->leaves[call->leaf_count - 1]), list);
+		jep_obj *arg_list = jep_arguments(*call, list);
+
+		if (func == NULL)
+		{
+			printf("couldn't find a function with the specified identifer\n");
+			jep_destroy_object(arg_list);
+			return NULL;
+		}
+
+		o = jep_tail_call(func, arg_list, list);
+		if (o != NULL)
+		{
+			o->ret |= 1;
+		}
+	}
+	else if (node.leaf_count == 1)
+	{
+		o = jep_evaluate(&(node.leaves[0]), list);
 		o->ret |= 1;
 	}
 	else if (node.leaf_count == 0)
@@ -3714,14 +3190,14 @@ jep_obj *jep_return(jep_ast_node node, jep_obj *list)
 /* evaluates a comma tree */
 jep_obj *jep_comma(jep_ast_node node, jep_obj *list)
 {
-	jep_ast_node l = node.leaves[0]; /* left operand  */
-	jep_ast_node r = node.leaves[1]; /* right operand */
+	jep_ast_node *l = &(node.leaves[0]); /* left operand  */
+	jep_ast_node *r = &(node.leaves[1]); /* right operand */
 	jep_obj *lo = NULL;				 /* left object   */
 	jep_obj *ro = NULL;				 /* right object  */
 
-	if (l.token.token_code == T_COMMA)
+	if (l->token.token_code == T_COMMA)
 	{
-		lo = jep_comma(l, list);
+		lo = jep_comma(*l, list);
 		jep_destroy_object(lo);
 	}
 	else
@@ -3730,9 +3206,9 @@ jep_obj *jep_comma(jep_ast_node node, jep_obj *list)
 		jep_destroy_object(lo);
 	}
 
-	if (r.token.token_code == T_COMMA)
+	if (r->token.token_code == T_COMMA)
 	{
-		ro = jep_comma(r, list);
+		ro = jep_comma(*r, list);
 	}
 	else
 	{
@@ -3747,7 +3223,7 @@ jep_obj *jep_reference(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 
-	jep_obj *v = jep_evaluate(node.leaves[0], list);
+	jep_obj *v = jep_evaluate(&(node.leaves[0]), list);
 
 	if (v != NULL)
 	{
@@ -3766,7 +3242,7 @@ jep_obj *jep_dereference(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 
-	jep_obj *v = jep_evaluate(node.leaves[0], list);
+	jep_obj *v = jep_evaluate(&(node.leaves[0]), list);
 
 	if (v != NULL)
 	{
@@ -3802,54 +3278,82 @@ jep_obj *jep_dereference(jep_ast_node node, jep_obj *list)
 /* evaluates a comma-delimited sequence of objects */
 void jep_sequence(jep_ast_node node, jep_obj *list, jep_obj *seq)
 {
-	jep_ast_node l = node.leaves[0]; /* left operand  */
-	jep_ast_node r = node.leaves[1]; /* right operand */
+	jep_ast_node *l = &(node.leaves[0]); /* left operand  */
+	jep_ast_node *r = &(node.leaves[1]); /* right operand */
 	jep_obj *lo = NULL;				 /* left object   */
 	jep_obj *ro = NULL;				 /* right object  */
 
-	if (l.token.token_code == T_COMMA)
+	if (l->token.token_code == T_COMMA)
 	{
-		jep_sequence(l, list, seq);
+		jep_sequence(*l, list, seq);
 	}
 	else
 	{
 		lo = jep_evaluate(l, list);
-		jep_add_object(seq, lo);
+		if (lo != NULL)
+		{
+			jep_add_object(seq, lo);
+		}
 	}
 
-	if (r.token.token_code == T_COMMA)
+	if (r->token.token_code == T_COMMA)
 	{
-		jep_sequence(r, list, seq);
+		jep_sequence(*r, list, seq);
 	}
 	else
 	{
 		ro = jep_evaluate(r, list);
-		jep_add_object(seq, ro);
+		if (ro != NULL)
+		{
+			jep_add_object(seq, ro);
+		}
 	}
 }
 
-/* evaluates an if statement */
+/*
+ * evaluates an if statement.
+ * an else if is followed in a loop, so a chain of them doesn't nest
+ * on the C stack.
+ */
 jep_obj *jep_if(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
-	jep_ast_node cond; /* condition        */
-	jep_ast_node body; /* body             */
-	jep_ast_node els;  /* else and else if */
+	jep_ast_node *branch = &node; /* the if being evaluated */
+	jep_ast_node *body;           /* the body to evaluate   */
+	jep_ast_node *els;            /* else and else if       */
 
-	if (node.leaf_count < 2)
+	while (branch != NULL && branch->leaf_count >= 2)
 	{
-		return o;
-	}
+		jep_obj *c = jep_evaluate(&(branch->leaves[0]), list);
 
-	cond = node.leaves[0];
-	body = node.leaves[1];
+		body = NULL;
+		els = branch->leaf_count == 3 ? &(branch->leaves[2]) : NULL;
+		if (c == NULL || c->type != JEP_INT)
+		{
+			return o;
+		}
 
-	jep_obj *c = jep_evaluate(cond, list);
+		if (*((int *)(c->val)))
+		{
+			body = &(branch->leaves[1]);
+			branch = NULL;
+		}
+		else if (els != NULL && els->token.token_code == T_IF)
+		{
+			branch = els;
+		}
+		else
+		{
+			if (els != NULL && els->token.token_code == T_ELSE
+				&& els->leaf_count == 1)
+			{
+				body = &(els->leaves[0]);
+			}
+			branch = NULL;
+		}
+		jep_destroy_object(c);
 
-	if (c != NULL && c->type == JEP_INT)
-	{
-		int val = *((int *)(c->val));
-		if (val)
+		if (body != NULL)
 		{
 			/* add a list for scope */
 			jep_obj *scope = jep_create_object();
@@ -3861,46 +3365,28 @@ jep_obj *jep_if(jep_ast_node node, jep_obj *list)
 			/* remove the argument list from the main list */
 			jep_remove_scope(list);
 			jep_destroy_list(scope);
-			free(scope);
+			jep_pool_free(scope, sizeof(jep_obj));
 		}
-		else if (node.leaf_count == 3)
-		{
-			els = node.leaves[2];
-			if (els.token.token_code == T_IF)
-			{
-				o = jep_if(els, list);
-			}
-			else if (els.token.token_code == T_ELSE && els.leaf_count == 1)
-			{
-				/* add a list for scope */
-				jep_obj *scope = jep_create_object();
-				scope->type = JEP_LIST;
-				jep_add_object(list, scope);
-
-				o = jep_evaluate(els.leaves[0], list);
-
-				/* remove the argument list from the main list */
-				jep_remove_scope(list);
-				jep_destroy_list(scope);
-				free(scope);
-			}
-		}
-		jep_destroy_object(c);
 	}
 
 	return o;
 }
 
-/* evaluates a switch statement */
+/*
+ * evaluates a switch statement.
+ * a switch with a jump table goes straight to the block of its value,
+ * otherwise the labels are evaluated in order until one matches.
+ */
 jep_obj* jep_switch(jep_ast_node node, jep_obj* list)
 {
 	jep_obj *o = NULL;
+	jep_obj *scope = NULL;
 
-	jep_ast_node exp;  /* the switch expression            */
-	jep_ast_node body; /* the body of the switch statement */
+	jep_ast_node *exp;  /* the switch expression            */
+	jep_ast_node *body; /* the body of the switch statement */
 
-	exp = node.leaves[0].leaves[0];
-	body = node.leaves[1];
+	exp = &(node.leaves[0].leaves[0]);
+	body = &(node.leaves[1]);
 
 	jep_obj *check = jep_evaluate(exp, list);
 
@@ -3915,82 +3401,125 @@ jep_obj* jep_switch(jep_ast_node node, jep_obj* list)
 	}
 
 	/* add a list for scope */
-	jep_obj *scope = jep_create_object();
-	scope->type = JEP_LIST;
-	jep_add_object(list, scope);
+	if (!(node.loop & JEP_UNSCOPED))
+	{
+		scope = jep_create_object();
+		scope->type = JEP_LIST;
+		jep_add_object(list, scope);
+	}
 
-	int match = 0;
-	int i;
-	for (i = 0; i < body.leaf_count && !match; i++)
+	if (node.cases != NULL)
 	{
-		int j;
-		for (j = 0; j < body.leaves[i].leaf_count && !match; j++)
+		jep_ast_node *block = jep_find_case(node.cases, check);
+		if (block != NULL)
 		{
-			if (body.leaves[i].token.token_code == T_DEFAULT)
-			{
-				match = 1;
-				o = jep_brace(body.leaves[i], list);
-			}
-			else
+			o = jep_brace(*block, list);
+		}
+	}
+	else
+	{
+		int match = 0;
+		int i;
+		for (i = 0; i < body->leaf_count && !match; i++)
+		{
+			int j;
+			for (j = 0; j < body->leaves[i].leaf_count && !match; j++)
 			{
-				if (body.leaves[i].leaves[j].token.token_code == T_DEFAULT)
+				if (body->leaves[i].token.token_code == T_DEFAULT)
 				{
 					match = 1;
-					o = jep_brace(body.leaves[i].leaves[j], list);
+					o = jep_brace(body->leaves[i], list);
 				}
 				else
 				{
-					jep_obj *cond = jep_evaluate(body.leaves[i].leaves[j], list);
-					if (cond != NULL && cond->ret && cond->ret & JEP_EXCEPTION)
+					if (body->leaves[i].leaves[j].token.token_code == T_DEFAULT)
 					{
-						/* remove the argument list from the main list */
-						jep_remove_scope(list);
-						jep_destroy_list(scope);
-						free(scope);
-
-						jep_destroy_object(check);
-
-						return cond;
+						match = 1;
+						o = jep_brace(body->leaves[i].leaves[j], list);
 					}
-
-					if (jep_compare_object(check, cond))
+					else
 					{
-						match = 1;
-						o = jep_brace(body.leaves[i].leaves[body.leaves[i].leaf_count - 1], list);
+						jep_obj *cond = jep_evaluate(&(body->leaves[i].leaves[j]), list);
+						if (cond != NULL && cond->ret && cond->ret & JEP_EXCEPTION)
+						{
+							/* remove the argument list from the main list */
+							if (scope != NULL)
+							{
+								jep_remove_scope(list);
+								jep_destroy_list(scope);
+								jep_pool_free(scope, sizeof(jep_obj));
+							}
+
+							jep_destroy_object(check);
+
+							return cond;
+						}
+
+						if (jep_compare_object(check, cond))
+						{
+							match = 1;
+							o = jep_brace(body->leaves[i].leaves[body->leaves[i].leaf_count - 1], list);
+						}
+
+						jep_destroy_object(cond);
 					}
-
-					jep_destroy_object(cond);
 				}
 			}
 		}
 	}
 
 	/* remove the argument list from the main list */
-	jep_remove_scope(list);
-	jep_destroy_list(scope);
-	free(scope);
+	if (scope != NULL)
+	{
+		jep_remove_scope(list);
+		jep_destroy_list(scope);
+		jep_pool_free(scope, sizeof(jep_obj));
+	}
 
 	jep_destroy_object(check);
 
 	return o;
 }
 
+/* adds the scope that is used by every iteration of a loop */
+static jep_obj *jep_push_loop_scope(jep_ast_node *node, jep_obj *list)
+{
+	jep_obj *scope = NULL;
+
+	if (!(node->loop & JEP_UNSCOPED))
+	{
+		scope = jep_create_object();
+		scope->type = JEP_LIST;
+		jep_add_object(list, scope);
+	}
+
+	return scope;
+}
+
+/* removes the scope of a loop after its last iteration */
+static void jep_pop_loop_scope(jep_obj *scope, jep_obj *list)
+{
+	if (scope != NULL)
+	{
+		jep_remove_scope(list);
+		jep_destroy_object(scope);
+	}
+}
+
 /* evaluates an for loop */
 jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 	jep_obj *scope;
 
-	jep_ast_node head = node.leaves[0];
+	jep_ast_node *head = &(node.leaves[0]);
 	jep_obj *cond = NULL;
-	jep_ast_node index_node;
-	jep_ast_node cond_node;
-	jep_ast_node change_node;
+	jep_ast_node *cond_node = NULL;
+	jep_ast_node *change_node = NULL;
 
 	if (node.loop & JEP_INDEX)
 	{
-		index_node = head.leaves[0];
-		jep_obj* index_obj = jep_evaluate(index_node, list);
+		jep_obj* index_obj = jep_evaluate(&(head->leaves[0]), list);
 		if (index_obj != NULL)
 		{
 			jep_destroy_object(index_obj);
@@ -4001,11 +3530,11 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 	{
 		if (node.loop & JEP_INDEX)
 		{
-			cond_node = head.leaves[1];
+			cond_node = &(head->leaves[1]);
 		}
 		else
 		{
-			cond_node = head.leaves[0];
+			cond_node = &(head->leaves[0]);
 		}
 	}
 
@@ -4013,15 +3542,15 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 	{
 		if (node.loop & JEP_INDEX && node.loop & JEP_CONDITION)
 		{
-			change_node = head.leaves[2];
+			change_node = &(head->leaves[2]);
 		}
 		else if (node.loop & JEP_INDEX || node.loop & JEP_CONDITION)
 		{
-			change_node = head.leaves[1];
+			change_node = &(head->leaves[1]);
 		}
 		else
 		{
-			change_node = head.leaves[0];
+			change_node = &(head->leaves[0]);
 		}
 	}
 
@@ -4037,21 +3566,16 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 				jep_destroy_object(cond);
 				cond = NULL;
 			}
+			/* every iteration uses the same scope */
+			scope = jep_push_loop_scope(&node, list);
 			while (val)
 			{
-				/* create the scope for this iteration */
-				scope = jep_create_object();
-				scope->type = JEP_LIST;
-				jep_add_object(list, scope);
-
 				if (node.leaf_count == 2)
 				{
-					o = jep_evaluate(node.leaves[1], list);
+					o = jep_evaluate(&(node.leaves[1]), list);
 					if (o != NULL && o->ret)
 					{
-						jep_remove_scope(list);
-						jep_destroy_object(scope);
-						scope = NULL;
+						jep_pop_loop_scope(scope, list);
 						return o;
 					}
 					else if (o != NULL)
@@ -4060,28 +3584,37 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 						o = NULL;
 					}
 				}
-				if (node.loop & JEP_CHANGE)
+				if (node.loop & JEP_COUNTED)
+				{
+					val = jep_count(&node, list);
+				}
+				else
 				{
-					jep_obj* change_obj = jep_evaluate(change_node, list);
-					if (change_obj != NULL)
+					if (node.loop & JEP_CHANGE)
 					{
-						jep_destroy_object(change_obj);
+						jep_obj* change_obj = jep_evaluate(change_node, list);
+						if (change_obj != NULL)
+						{
+							jep_destroy_object(change_obj);
+						}
+					}
+
+					cond = jep_evaluate(cond_node, list);
+					if (cond != NULL && cond->val != NULL)
+					{
+						val = *((int *)(cond->val));
+						jep_destroy_object(cond);
+						cond = NULL;
 					}
 				}
 
-				cond = jep_evaluate(cond_node, list);
-				if (cond != NULL && cond->val != NULL)
+				/* clear the scope at the end of each iteration */
+				if (scope != NULL)
 				{
-					val = *((int *)(cond->val));
-					jep_destroy_object(cond);
-					cond = NULL;
+					jep_clear_scope(scope);
 				}
-
-				/* destroy the scope at the end of each iteration */
-				jep_remove_scope(list);
-				jep_destroy_object(scope);
-				scope = NULL;
 			}
+			jep_pop_loop_scope(scope, list);
 		}
 		else
 		{
@@ -4090,20 +3623,16 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 	}
 	else
 	{
+		/* every iteration uses the same scope */
+		scope = jep_push_loop_scope(&node, list);
 		while (1)
 		{
-			/* create the scope for this iteration */
-			scope = jep_create_object();
-			scope->type = JEP_LIST;
-			jep_add_object(list, scope);
-
 			if (node.leaf_count == 2)
 			{
-				o = jep_evaluate(node.leaves[1], list);
+				o = jep_evaluate(&(node.leaves[1]), list);
 				if (o != NULL && o->ret)
 				{
-					jep_remove_scope(list);
-					jep_destroy_object(scope);
+					jep_pop_loop_scope(scope, list);
 					return o;
 				}
 				else if (o != NULL)
@@ -4121,27 +3650,76 @@ jep_obj *jep_for(jep_ast_node node, jep_obj *list)
 				}
 			}
 
-			/* destroy the scope at the end of each iteration */
-			jep_remove_scope(list);
-			jep_destroy_object(scope);
-			scope = NULL;
+			/* clear the scope at the end of each iteration */
+			if (scope != NULL)
+			{
+				jep_clear_scope(scope);
+			}
 		}
 	}
 
 	return o;
 }
 
+/*
+ * increments the index of a counted for loop and compares it with the
+ * limit. the index is changed in place and no objects are created
+ * while the index and the limit are ints, otherwise the increment and
+ * the condition are evaluated as usual.
+ */
+int jep_count(jep_ast_node *node, jep_obj *list)
+{
+	jep_ast_node *head = &(node->leaves[0]);
+	jep_ast_node *cond = &(head->leaves[1]);
+	jep_obj *index;
+	jep_obj *limit;
+	jep_obj *o;
+	int val = 1;
+
+	index = jep_lookup(&(cond->leaves[0]), list);
+	if (cond->leaves[1].value != NULL)
+	{
+		limit = cond->leaves[1].value;
+	}
+	else
+	{
+		limit = jep_lookup(&(cond->leaves[1]), list);
+	}
+
+	if (index != NULL && limit != NULL
+		&& index->type == JEP_INT && limit->type == JEP_INT)
+	{
+		return ++JEP_I(index) < JEP_I(limit);
+	}
+
+	o = jep_evaluate(&(head->leaves[2]), list);
+	if (o != NULL)
+	{
+		jep_destroy_object(o);
+	}
+
+	/* a condition without a value doesn't end the loop */
+	o = jep_evaluate(cond, list);
+	if (o != NULL)
+	{
+		if (o->val != NULL)
+		{
+			val = *((int *)(o->val));
+		}
+		jep_destroy_object(o);
+	}
+
+	return val;
+}
+
 /* evaluates a while loop */
 jep_obj *jep_while(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 	jep_obj *scope = NULL;
 
-	jep_ast_node head = node.leaves[0];
 	jep_obj *cond = NULL;
-	jep_ast_node cond_node;
-
-	cond_node = head.leaves[0];
+	jep_ast_node *cond_node = &(node.leaves[0].leaves[0]);
 
 	cond = jep_evaluate(cond_node, list);
 	if (cond != NULL && cond->type == JEP_INT)
@@ -4153,21 +3731,16 @@ jep_obj *jep_while(jep_ast_node node, jep_obj *list)
 			jep_destroy_object(cond);
 			cond = NULL;
 		}
+		/* every iteration uses the same scope */
+		scope = jep_push_loop_scope(&node, list);
 		while (val)
 		{
-			/* create the scope for this iteration */
-			scope = jep_create_object();
-			scope->type = JEP_LIST;
-			jep_add_object(list, scope);
-
 			if (node.leaf_count == 2)
 			{
-				o = jep_evaluate(node.leaves[1], list);
+				o = jep_evaluate(&(node.leaves[1]), list);
 				if (o != NULL && o->ret)
 				{
-					jep_remove_scope(list);
-					jep_destroy_object(scope);
-					scope = NULL;
+					jep_pop_loop_scope(scope, list);
 					return o;
 				}
 				else if (o != NULL)
@@ -4185,11 +3758,13 @@ jep_obj *jep_while(jep_ast_node node, jep_obj *list)
 				cond = NULL;
 			}
 
-			/* destroy the scope at the end of each iteration */
-			jep_remove_scope(list);
-			jep_destroy_object(scope);
-			scope = NULL;
+			/* clear the scope at the end of each iteration */
+			if (scope != NULL)
+			{
+				jep_clear_scope(scope);
+			}
 		}
+		jep_pop_loop_scope(scope, list);
 	}
 	else
 	{
@@ -4205,9 +3780,9 @@ jep_obj* jep_try(jep_ast_node node, jep_obj* list)
 	jep_obj *o = NULL;
 	jep_obj *scope = NULL;
 
-	jep_ast_node try_body = node.leaves[0];
-	jep_ast_node ex = node.leaves[1].leaves[0];
-	jep_ast_node catch_body = node.leaves[1].leaves[1];
+	jep_ast_node *try_body = &(node.leaves[0]);
+	jep_ast_node *ex = &(node.leaves[1].leaves[0]);
+	jep_ast_node *catch_body = &(node.leaves[1].leaves[1]);
 
 	/* create the scope for the try block */
 	scope = jep_create_object();
@@ -4232,8 +3807,9 @@ jep_obj* jep_try(jep_ast_node node, jep_obj* list)
 		if (o->ret & JEP_EXCEPTION)
 		{
 			jep_obj *exception = jep_create_object();
-			exception->ident = ex.token.val->buffer;
-			jep_copy_object(exception, o);
+			exception->ident = ex->token.val->buffer;
+			jep_move_object(exception, o);
+			exception->ret = 0; /* the caught value is no longer thrown */
 			jep_destroy_object(o);
 			o = NULL;
 
@@ -4269,7 +3845,7 @@ jep_obj* jep_throw(jep_ast_node node, jep_obj* list)
 {
 	jep_obj *o = NULL;
 
-	o = jep_evaluate(node.leaves[0], list);
+	o = jep_evaluate(&(node.leaves[0]), list);
 	o->ret = JEP_RETURN | JEP_EXCEPTION;
 
 	return o;
@@ -4285,7 +3861,7 @@ int jep_has_data_member(jep_obj *members, const char *ident)
 		jep_obj *mem = members->head;
 		while (mem != NULL)
 		{
-			if (!strcmp(mem->ident, ident))
+			if (mem->ident == ident)
 			{
 				has = 1;
 			}
@@ -4313,6 +3889,9 @@ jep_obj *jep_struct(jep_ast_node node, jep_obj *list)
 
 	struc->ident = node.leaves[0].token.val->buffer;
 
+	/* instances of the definition have its members in the same slots */
+	struc->shape = &(node.leaves[1]);
+
 	jep_obj *members = jep_create_object();
 	members->type = JEP_LIST;
 
@@ -4381,11 +3960,12 @@ jep_obj *jep_new(jep_ast_node node, jep_obj *list)
 	/* get the values from a structure initialization */
 	if (node.leaf_count == 2)
 	{
-		init = jep_evaluate(node.leaves[1], list);
+		init = jep_evaluate(&(node.leaves[1]), list);
 	}
 
 	new_obj = jep_create_object();
 	new_obj->type = JEP_STRUCT;
+	new_obj->shape = struct_def->shape;
 
 	members = jep_create_object();
 	members->type = JEP_LIST;
@@ -4395,12 +3975,21 @@ jep_obj *jep_new(jep_ast_node node, jep_obj *list)
 	def_mem = def_members->head;
 	if (init != NULL && init->size > 0)
 	{
+		/* the values of an initializer that isn't shared are moved */
+		int owned = ((jep_obj *)(init->val))->refs <= 1;
 		jep_obj* init_obj = ((jep_obj*)(init->val))->head;
 		while (def_mem != NULL && init_obj != NULL)
 		{
 			jep_obj *mem = jep_create_object();
 			mem->ident = def_mem->ident;
-			jep_copy_object(mem, init_obj);
+			if (owned)
+			{
+				jep_move_object(mem, init_obj);
+			}
+			else
+			{
+				jep_copy_object(mem, init_obj);
+			}
 			mem->index = -2;
 			jep_add_object(members, mem);
 
@@ -4438,57 +4027,64 @@ jep_obj *jep_member(jep_ast_node node, jep_obj *list)
 		return NULL;
 	}
 
+	return jep_member_object(jep_evaluate(&(node.leaves[0]), list), &node);
+}
+
+/* accesses a member of a struct that has been evaluated */
+jep_obj *jep_member_object(jep_obj *struc, jep_ast_node *node)
+{
 	jep_obj *mem;
-	jep_obj *struc;
 	jep_obj *members;
 
-	struc = jep_evaluate(node.leaves[0], list);
-
 	if (struc == NULL)
 	{
 		printf("could not obtain object with identifier %s\n",
-			node.leaves[0].token.val->buffer);
+			node->leaves[0].token.val->buffer);
 		return NULL;
 	}
+	else if (struc->ret & JEP_EXCEPTION)
+	{
+		return struc;
+	}
 	else if (struc->type != JEP_STRUCT)
 	{
 		printf("%s is not a struct\n",
-			node.leaves[0].token.val->buffer);
+			node->leaves[0].token.val->buffer);
 		jep_destroy_object(struc);
 		return NULL;
 	}
 
-	if (node.leaves[1].token.type != T_IDENTIFIER)
+	if (node->leaves[1].token.type != T_IDENTIFIER)
 	{
 		printf("an identifier must be used to access data members\n");
 		jep_destroy_object(struc);
 		return NULL;
 	}
 
+	/* a member that is assigned to can't be shared with other structs */
+	if (node->target)
+	{
+		jep_unshare(struc);
+	}
+
 	members = (jep_obj *)(struc->val);
 	mem = NULL;
 
 	if (members->size > 0)
 	{
-		jep_obj *m = members->head;
-		int found = 0;
-		while (m != NULL && mem == NULL && !found)
+		jep_obj *m = jep_find_member(struc, &(node->leaves[1]));
+		if (m != NULL)
 		{
-			if (!strcmp(m->ident, node.leaves[1].token.val->buffer))
-			{
-				mem = jep_create_object();
-				jep_copy_object(mem, m);
-				mem->index = -2;
-				mem->ident = m->ident;
-				jep_copy_self(mem, m);
-				found = 1;
-			}
-			m = m->next;
+			mem = jep_create_object();
+			jep_copy_object(mem, m);
+			mem->index = -2;
+			mem->ident = m->ident;
+			jep_copy_self(mem, m);
 		}
-		if (mem == NULL)
+		else
 		{
 			printf("%s does not have a member with the identifier %s\n",
-				struc->ident, node.leaves[1].token.val->buffer);
+				struc->ident, node->leaves[1].token.val->buffer);
 		}
 	}
 	else
@@ -4508,22 +4104,22 @@ jep_obj *jep_modifier(jep_ast_node node, jep_obj *list)
 {
 	jep_obj *o = NULL;
 	int mod = node.mod;
-	jep_ast_node exp;
+	jep_ast_node *exp;
 
 	if (node.leaf_count < 1)
 	{
 		return o;
 	}
 
-	exp = node.leaves[node.leaf_count - 1];
+	exp = &(node.leaves[node.leaf_count - 1]);
 
-	if (exp.leaf_count > 0 && exp.token.token_code == T_COMMA)
+	if (exp->leaf_count > 0 && exp->token.token_code == T_COMMA)
 	{
-		o = jep_mod_sequence(exp, list, mod);
+		o = jep_mod_sequence(*exp, list, mod);
 	}
 	else
 	{
-		o = jep_evaluate_local(exp, list, mod);
+		o = jep_evaluate_local(*exp, list, mod);
 	}
 
 	return o;
@@ -4533,8 +4129,8 @@ jep_obj *jep_modifier(jep_ast_node node, jep_obj *list)
 jep_obj* jep_mod_sequence(jep_ast_node node, jep_obj *list, int mod)
 {
 	jep_obj *o = NULL;
-	jep_ast_node l = node.leaves[0]; /* left operand  */
-	jep_ast_node r = node.leaves[1]; /* right operand */
+	jep_ast_node *l = &(node.leaves[0]); /* left operand  */
+	jep_ast_node *r = &(node.leaves[1]); /* right operand */
 
 	/*
 	 * modified expressions can only be assignments or declarations.
@@ -4542,13 +4138,13 @@ jep_obj* jep_mod_sequence(jep_ast_node node, jep_obj *list, int mod)
 	 * assignment with an identifier as its left operand.
 	 */
 
-	if (l.token.token_code == T_COMMA)
+	if (l->token.token_code == T_COMMA)
 	{
-		o = jep_mod_sequence(l, list, mod);
+		o = jep_mod_sequence(*l, list, mod);
 	}
 	else
 	{
-		o = jep_evaluate_local(l, list, mod);
+		o = jep_evaluate_local(*l, list, mod);
 	}
 
 	if (o != NULL)
@@ -4560,13 +4156,13 @@ jep_obj* jep_mod_sequence(jep_ast_node node, jep_obj *list, int mod)
 		jep_destroy_object(o);
 	}
 
-	if (r.token.token_code == T_COMMA)
+	if (r->token.token_code == T_COMMA)
 	{
-		o = jep_mod_sequence(r, list, mod);
+		o = jep_mod_sequence(*r, list, mod);
 	}
 	else
 	{
-		o = jep_evaluate_local(r, list, mod);
+		o = jep_evaluate_local(*r, list, mod);
 	}
 
 	return o;
@@ -4610,6 +4206,7 @@ jep_obj *jep_evaluate_local(jep_ast_node ast, jep_obj *list, int mod)
 				jep_add_object(scope, local);
 				jep_obj *con = jep_get_object(local->ident, scope);
 				con->mod = mod;
+				jep_bind_slot(&ast, list, local);
 			}
 		}
 		else if (mod & 1 && !(mod & 2))
@@ -4620,6 +4217,7 @@ jep_obj *jep_evaluate_local(jep_ast_node ast, jep_obj *list, int mod)
 			jep_add_object(scope, local);
 			jep_obj *con = jep_get_object(local->ident, scope);
 			con->mod = mod;
+			jep_bind_slot(&ast, list, local);
 		}
 		else
 		{
@@ -4670,6 +4268,7 @@ jep_obj *jep_evaluate_local(jep_ast_node ast, jep_obj *list, int mod)
 					jep_obj *con = jep_get_object(local->ident, scope);
 					con->mod = mod;
 				}
+				jep_bind_slot(&(ast.leaves[0]), list, local);
 			}
 		}
 		else if (mod & 1 && !(mod & 2))
@@ -4679,6 +4278,7 @@ jep_obj *jep_evaluate_local(jep_ast_node ast, jep_obj *list, int mod)
 			local->ident = ast.leaves[0].token.val->buffer;
 			jep_add_object(scope, local);
 			o = jep_assign(ast, list);
+			jep_bind_slot(&(ast.leaves[0]), list, local);
 			if (o != NULL && (o->ret & JEP_EXCEPTION))
 			{
 				return o;
@@ -0,0 +1,872 @@
+/*
+	Functions for simplifying an abstract syntax tree before it is run
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <math.h>
+#include "swap/optimizer.h"
+#include "swap/parser.h"
+#include "swap/resolver.h"
+
+/*
+ * The optimizer only rewrites what can be decided without running
+ * the program. An operation is folded when its operands are literals
+ * and applying it can't fail, so it produces the same value and prints
+ * nothing. Since Swap is dynamically scoped, a const global is only
+ * replaced by its value if no other part of the program can declare
+ * or assign to an object with the same name.
+ */
+
+/* what to do with a statement after it has been optimized */
+#define JEP_KEEP 0
+#define JEP_REMOVE 1
+
+/* the const globals whose values are known */
+typedef struct Optimizer
+{
+	jep_token_stream *ts; /* interns the text of new literals    */
+	jep_obj *constants;   /* the constant pool                   */
+	jep_ast_node *root;   /* the root of the AST                 */
+	const char **names;   /* identifiers of the const globals    */
+	jep_ast_node *values; /* literal values of the const globals */
+	int size;             /* number of const globals             */
+	int cap;              /* capacity                            */
+}jep_optimizer;
+
+static int jep_optimize_node(jep_optimizer *opt, jep_ast_node *node);
+
+/* checks if a node is a literal */
+static int jep_is_literal(jep_ast_node *node)
+{
+	return node->token.type == T_NUMBER
+		|| node->token.type == T_CHARACTER
+		|| node->token.type == T_STRING;
+}
+
+/*
+ * frees the leaves of a node that is removed from the AST.
+ * like the rest of the AST, the nodes themselves are stored in the
+ * leaves of their parents, so only the arrays of leaves are freed.
+ */
+static void jep_free_leaves(jep_ast_node *node)
+{
+	int i;
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_free_leaves(&(node->leaves[i]));
+	}
+
+	if (node->leaves != NULL)
+	{
+		free(node->leaves);
+	}
+	node->leaves = NULL;
+	node->leaf_count = 0;
+}
+
+/* checks if a node is a pair of parentheses that groups an expression */
+static int jep_is_group(jep_ast_node *node)
+{
+	return node->token.type == T_SYMBOL
+		&& node->token.token_code == T_LPAREN
+		&& !node->token.postfix
+		&& node->leaf_count == 1;
+}
+
+/* checks if an object is a number */
+static int jep_is_number(jep_obj *o)
+{
+	return o->type == JEP_BYTE || o->type == JEP_INT
+		|| o->type == JEP_LONG || o->type == JEP_DOUBLE;
+}
+
+/* checks if an object is an integer */
+static int jep_is_integer(jep_obj *o)
+{
+	return o->type == JEP_BYTE || o->type == JEP_INT || o->type == JEP_LONG;
+}
+
+/* gets the value of an integer object */
+static long jep_integer(jep_obj *o)
+{
+	if (o->type == JEP_BYTE)
+	{
+		return *(unsigned char *)(o->val);
+	}
+	else if (o->type == JEP_INT)
+	{
+		return *(int *)(o->val);
+	}
+
+	return *(long *)(o->val);
+}
+
+/* checks if an operation can be applied to two literals without failing */
+static int jep_foldable(int code, jep_obj *l, jep_obj *r)
+{
+	switch (code)
+	{
+	case T_PLUS:
+		if (l->type == JEP_STRING || r->type == JEP_STRING)
+		{
+			return 1;
+		}
+		return jep_is_number(l) && jep_is_number(r);
+
+	case T_MINUS:
+	case T_STAR:
+	case T_LESS:
+	case T_GREATER:
+	case T_LOREQUAL:
+	case T_GOREQUAL:
+	case T_LOGAND:
+	case T_LOGOR:
+		return jep_is_number(l) && jep_is_number(r);
+
+	case T_FSLASH:
+		if (!jep_is_number(l) || !jep_is_number(r))
+		{
+			return 0;
+		}
+		/* an integer division by 0 or -1 could trap */
+		return !jep_is_integer(r)
+			|| (jep_integer(r) != 0 && jep_integer(r) != -1);
+
+	case T_MODULUS:
+		return l->type == JEP_INT && r->type == JEP_INT
+			&& jep_integer(r) != 0 && jep_integer(r) != -1;
+
+	case T_EQUIVALENT:
+	case T_NOTEQUIVALENT:
+		if (l->type == JEP_STRING && r->type == JEP_STRING)
+		{
+			return 1;
+		}
+		return jep_is_number(l) && jep_is_number(r);
+
+	case T_BITAND:
+	case T_BITOR:
+	case T_BITXOR:
+		return jep_is_integer(l) && jep_is_integer(r);
+
+	case T_LSHIFT:
+	case T_RSHIFT:
+		return jep_is_integer(l) && jep_is_integer(r)
+			&& jep_integer(l) >= 0
+			&& jep_integer(r) >= 0 && jep_integer(r) < 32;
+
+	default:
+		return 0;
+	}
+}
+
+/* applies an operation to two literals */
+static jep_obj *jep_apply(int code, jep_obj *l, jep_obj *r)
+{
+	switch (code)
+	{
+	case T_PLUS:          return jep_add_objects(l, r);
+	case T_MINUS:         return jep_sub_objects(l, r);
+	case T_STAR:          return jep_mul_objects(l, r);
+	case T_FSLASH:        return jep_div_objects(l, r);
+	case T_MODULUS:       return jep_modulus_objects(l, r);
+	case T_LESS:          return jep_less_objects(l, r);
+	case T_GREATER:       return jep_greater_objects(l, r);
+	case T_LOREQUAL:      return jep_lorequal_objects(l, r);
+	case T_GOREQUAL:      return jep_gorequal_objects(l, r);
+	case T_EQUIVALENT:    return jep_equiv_objects(l, r);
+	case T_NOTEQUIVALENT: return jep_noteq_objects(l, r);
+	case T_BITAND:        return jep_bitand_objects(l, r);
+	case T_BITOR:         return jep_bitor_objects(l, r);
+	case T_BITXOR:        return jep_bitxor_objects(l, r);
+	case T_LSHIFT:        return jep_lshift_objects(l, r);
+	case T_RSHIFT:        return jep_rshift_objects(l, r);
+	case T_LOGAND:        return jep_and_objects(l, r);
+	case T_LOGOR:         return jep_or_objects(l, r);
+	default:              return NULL;
+	}
+}
+
+/*
+ * converts a value into the text of the literal that produces it,
+ * or returns NULL if no literal would produce the same value
+ */
+static char *jep_literal_text(jep_obj *o, int *type)
+{
+	char buf[64];
+
+	if (o == NULL || o->val == NULL)
+	{
+		return NULL;
+	}
+
+	*type = T_NUMBER;
+
+	if (o->type == JEP_BYTE)
+	{
+		sprintf(buf, "%ub", (unsigned int)*(unsigned char *)(o->val));
+	}
+	else if (o->type == JEP_INT)
+	{
+		sprintf(buf, "%d", *(int *)(o->val));
+	}
+	else if (o->type == JEP_LONG)
+	{
+		long n = *(long *)(o->val);
+
+		/* a literal that fits in an int is an int */
+		if (n >= INT_MIN && n <= INT_MAX)
+		{
+			return NULL;
+		}
+		sprintf(buf, "%ld", n);
+	}
+	else if (o->type == JEP_DOUBLE)
+	{
+		double d = *(double *)(o->val);
+
+		if (!isfinite(d))
+		{
+			return NULL;
+		}
+
+		/* a literal without a decimal point is an integer */
+		sprintf(buf, "%.17g", d);
+		if (strpbrk(buf, ".e") == NULL)
+		{
+			strcat(buf, ".0");
+		}
+	}
+	else if (o->type == JEP_STRING)
+	{
+		char *s = malloc(strlen((char *)(o->val)) + 1);
+		strcpy(s, (char *)(o->val));
+		*type = T_STRING;
+		return s;
+	}
+	else
+	{
+		return NULL;
+	}
+
+	char *s = malloc(strlen(buf) + 1);
+	strcpy(s, buf);
+	return s;
+}
+
+/* turns a node into a literal and adds its value to the constant pool */
+static void jep_set_literal(jep_optimizer *opt, jep_ast_node *node,
+	int type, const char *text)
+{
+	jep_intern(opt->ts, text);
+
+	node->token.val = jep_table_get(opt->ts->names, text);
+	node->token.type = type;
+	node->token.token_code = 0;
+	node->token.unary = 0;
+	node->token.postfix = 0;
+	jep_free_leaves(node);
+	node->array = 0;
+	node->loop = 0;
+	node->mod = 0;
+
+	node->value = jep_constant(node);
+	if (node->value != NULL)
+	{
+		jep_add_object(opt->constants, node->value);
+	}
+}
+
+/* replaces an operation on literals with its result */
+static void jep_fold(jep_optimizer *opt, jep_ast_node *node)
+{
+	int code = node->token.token_code;
+	jep_obj *l = NULL;
+	jep_obj *r = NULL;
+	jep_obj *result = NULL;
+	char *text;
+	int type;
+
+	if (node->token.type != T_SYMBOL)
+	{
+		return;
+	}
+
+	if (node->leaf_count == 1 && (code == T_NOT
+		|| (code == T_MINUS && node->token.unary)))
+	{
+		if (!jep_is_literal(&(node->leaves[0])))
+		{
+			return;
+		}
+
+		l = jep_literal(&(node->leaves[0]));
+		if (l == NULL || !jep_is_number(l))
+		{
+			jep_destroy_object(l);
+			return;
+		}
+
+		result = code == T_NOT ? jep_not_object(l) : jep_neg_object(l);
+	}
+	else if (node->leaf_count == 2 && !node->token.unary)
+	{
+		if (!jep_is_literal(&(node->leaves[0]))
+			|| !jep_is_literal(&(node->leaves[1])))
+		{
+			return;
+		}
+
+		l = jep_literal(&(node->leaves[0]));
+		r = jep_literal(&(node->leaves[1]));
+		if (l == NULL || r == NULL || !jep_foldable(code, l, r))
+		{
+			jep_destroy_object(l);
+			jep_destroy_object(r);
+			return;
+		}
+
+		result = jep_apply(code, l, r);
+	}
+	else
+	{
+		return;
+	}
+
+	text = jep_literal_text(result, &type);
+	jep_destroy_object(result);
+
+	if (text != NULL)
+	{
+		jep_set_literal(opt, node, type, text);
+		free(text);
+	}
+}
+
+/* optimizes an expression */
+static void jep_optimize_expression(jep_optimizer *opt, jep_ast_node *node)
+{
+	int i;
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_optimize_expression(opt, &(node->leaves[i]));
+	}
+
+	/* a literal doesn't need to be grouped */
+	if (jep_is_group(node) && jep_is_literal(&(node->leaves[0])))
+	{
+		jep_ast_node *group = node->leaves;
+		*node = group[0];
+		free(group);
+		return;
+	}
+
+	jep_fold(opt, node);
+}
+
+/* optimizes the values in a chain of modified declarations */
+static void jep_optimize_declaration(jep_optimizer *opt, jep_ast_node *node)
+{
+	if (node->token.token_code == T_COMMA && node->leaf_count == 2)
+	{
+		jep_optimize_declaration(opt, &(node->leaves[0]));
+		jep_optimize_declaration(opt, &(node->leaves[1]));
+	}
+	else if (node->token.token_code == T_EQUALS && node->leaf_count == 2)
+	{
+		jep_optimize_expression(opt, &(node->leaves[1]));
+	}
+}
+
+/* gets the value of a constant int condition */
+static int jep_condition(jep_ast_node *head, int *val)
+{
+	jep_obj *c;
+	int known = 0;
+
+	if (head->leaf_count != 1 || head->leaves[0].token.type != T_NUMBER)
+	{
+		return 0;
+	}
+
+	c = jep_literal(&(head->leaves[0]));
+	if (c != NULL && c->type == JEP_INT)
+	{
+		*val = *(int *)(c->val);
+		known = 1;
+	}
+	jep_destroy_object(c);
+
+	return known;
+}
+
+/* checks if a node is a block that doesn't need a scope of its own */
+static int jep_is_plain_block(jep_ast_node *node)
+{
+	return node->token.type == T_SYMBOL
+		&& node->token.token_code == T_LBRACE
+		&& !node->array
+		&& !jep_declares(node);
+}
+
+/* reduces an if statement with a constant condition to the branch taken */
+static int jep_optimize_if(jep_optimizer *opt, jep_ast_node *node)
+{
+	jep_ast_node *head = &(node->leaves[0]);
+	jep_ast_node els;
+	int val;
+
+	jep_optimize_expression(opt, &(head->leaves[0]));
+	jep_optimize_node(opt, &(node->leaves[1]));
+
+	if (node->leaf_count == 3)
+	{
+		els = node->leaves[2];
+		if (els.token.token_code == T_IF)
+		{
+			if (jep_optimize_node(opt, &(node->leaves[2])) == JEP_REMOVE)
+			{
+				jep_free_leaves(&(node->leaves[2]));
+				node->leaf_count = 2;
+			}
+		}
+		else if (els.leaf_count == 1)
+		{
+			jep_optimize_node(opt, &(node->leaves[2].leaves[0]));
+		}
+	}
+
+	if (!jep_condition(head, &val))
+	{
+		return JEP_KEEP;
+	}
+
+	if (!val)
+	{
+		if (node->leaf_count < 3)
+		{
+			return JEP_REMOVE;
+		}
+
+		els = node->leaves[2];
+		if (els.token.token_code == T_IF)
+		{
+			jep_ast_node *leaves = node->leaves;
+			jep_free_leaves(&(leaves[0]));
+			jep_free_leaves(&(leaves[1]));
+			*node = els;
+			free(leaves);
+			return JEP_KEEP;
+		}
+		else if (els.leaf_count != 1)
+		{
+			return JEP_KEEP;
+		}
+
+		/* the else branch is always taken */
+		jep_free_leaves(&(node->leaves[1]));
+		node->leaves[1] = els.leaves[0];
+		free(els.leaves);
+		jep_set_literal(opt, &(head->leaves[0]), T_NUMBER, "1");
+	}
+	else if (node->leaf_count == 3)
+	{
+		/* the else branch is never taken */
+		jep_free_leaves(&(node->leaves[2]));
+	}
+
+	node->leaf_count = 2;
+
+	/* a block that declares nothing can be run without the if */
+	if (jep_is_plain_block(&(node->leaves[1])))
+	{
+		jep_ast_node *leaves = node->leaves;
+		jep_free_leaves(&(leaves[0]));
+		*node = leaves[1];
+		free(leaves);
+	}
+
+	return JEP_KEEP;
+}
+
+/* optimizes a block of statements */
+static void jep_optimize_block(jep_optimizer *opt, jep_ast_node *node)
+{
+	int i = 0;
+	int j;
+
+	while (i < node->leaf_count)
+	{
+		jep_ast_node *stm = &(node->leaves[i]);
+
+		if (jep_optimize_node(opt, stm) == JEP_REMOVE)
+		{
+			jep_free_leaves(stm);
+			for (j = i + 1; j < node->leaf_count; j++)
+			{
+				node->leaves[j - 1] = node->leaves[j];
+			}
+			node->leaf_count--;
+			continue;
+		}
+
+		/* nothing after a return or throw is reached */
+		if (stm->token.type == T_KEYWORD
+			&& (stm->token.token_code == T_RETURN
+				|| stm->token.token_code == T_THROW))
+		{
+			for (j = i + 1; j < node->leaf_count; j++)
+			{
+				jep_free_leaves(&(node->leaves[j]));
+			}
+			node->leaf_count = i + 1;
+		}
+
+		i++;
+	}
+}
+
+/*
+ * optimizes a statement, returning whether it can be removed
+ * from the block that contains it
+ */
+static int jep_optimize_node(jep_optimizer *opt, jep_ast_node *node)
+{
+	int val;
+	int i;
+
+	if (node->token.type == T_KEYWORD)
+	{
+		switch (node->token.token_code)
+		{
+		case T_IF:
+			if (node->leaf_count >= 2 && node->leaves[0].leaf_count == 1)
+			{
+				return jep_optimize_if(opt, node);
+			}
+			break;
+
+		case T_WHILE:
+			if (node->leaf_count == 2 && node->leaves[0].leaf_count == 1)
+			{
+				jep_optimize_expression(opt, &(node->leaves[0].leaves[0]));
+				if (jep_condition(&(node->leaves[0]), &val) && !val)
+				{
+					return JEP_REMOVE;
+				}
+				jep_optimize_node(opt, &(node->leaves[1]));
+			}
+			break;
+
+		case T_FOR:
+			if (node->leaf_count == 2)
+			{
+				for (i = 0; i < node->leaves[0].leaf_count; i++)
+				{
+					jep_optimize_expression(opt, &(node->leaves[0].leaves[i]));
+				}
+				jep_optimize_node(opt, &(node->leaves[1]));
+			}
+			break;
+
+		case T_FUNCTION:
+			if (node->leaf_count == 3)
+			{
+				jep_optimize_node(opt, &(node->leaves[2]));
+			}
+			break;
+
+		case T_TRY:
+			if (node->leaf_count == 2)
+			{
+				jep_optimize_node(opt, &(node->leaves[0]));
+				if (node->leaves[1].leaf_count == 2)
+				{
+					jep_optimize_node(opt, &(node->leaves[1].leaves[1]));
+				}
+			}
+			break;
+
+		case T_RETURN:
+		case T_THROW:
+			if (node->leaf_count == 1)
+			{
+				jep_optimize_expression(opt, &(node->leaves[0]));
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+	else if (node->token.type == T_MODIFIER)
+	{
+		if (node->leaf_count > 0)
+		{
+			jep_optimize_declaration(opt, &(node->leaves[node->leaf_count - 1]));
+		}
+	}
+	else if (node->token.type == T_SYMBOL && node->token.token_code == T_LBRACE
+		&& !node->array)
+	{
+		jep_optimize_block(opt, node);
+	}
+	else
+	{
+		jep_optimize_expression(opt, node);
+	}
+
+	return JEP_KEEP;
+}
+
+/* checks if a node modifies its first operand */
+static int jep_is_assignment(jep_ast_node *node)
+{
+	if (node->token.type != T_SYMBOL || node->leaf_count < 1)
+	{
+		return 0;
+	}
+
+	switch (node->token.token_code)
+	{
+	case T_EQUALS:
+	case T_ADDASSIGN:
+	case T_SUBASSIGN:
+	case T_MULASSIGN:
+	case T_DIVASSIGN:
+	case T_MODASSIGN:
+	case T_ANDASSIGN:
+	case T_ORASSIGN:
+	case T_XORASSIGN:
+	case T_LSHIFTASSIGN:
+	case T_RSHIFTASSIGN:
+	case T_INCREMENT:
+	case T_DECREMENT:
+	case T_COLON:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+static int jep_propagate(jep_ast_node *node, const char *name,
+	jep_ast_node *value, int bound, int apply);
+
+/* visits the names in a chain of modified declarations */
+static int jep_propagate_declaration(jep_ast_node *node, const char *name,
+	jep_ast_node *value, int apply)
+{
+	if (node->token.token_code == T_COMMA && node->leaf_count == 2)
+	{
+		return jep_propagate_declaration(&(node->leaves[0]), name, value, apply)
+			+ jep_propagate_declaration(&(node->leaves[1]), name, value, apply);
+	}
+
+	return jep_propagate(node, name, value,
+		node->token.type == T_IDENTIFIER, apply);
+}
+
+/*
+ * counts the places where a name is declared or assigned to, and if
+ * apply is set, replaces the places where it is only read with a value.
+ * bound is set for a name that is declared or assigned to.
+ */
+static int jep_propagate(jep_ast_node *node, const char *name,
+	jep_ast_node *value, int bound, int apply)
+{
+	int count = 0;
+	int first = 0;
+	int i;
+
+	if (node->token.type == T_IDENTIFIER)
+	{
+		if (node->token.val->buffer != name)
+		{
+			return 0;
+		}
+		else if (bound)
+		{
+			return 1;
+		}
+		else if (apply)
+		{
+			node->token.val = value->token.val;
+			node->token.type = value->token.type;
+			node->token.token_code = value->token.token_code;
+			node->value = value->value;
+		}
+		return 0;
+	}
+
+	if (node->token.type == T_MODIFIER)
+	{
+		if (node->leaf_count > 0)
+		{
+			count = jep_propagate_declaration(&(node->leaves[node->leaf_count - 1]),
+				name, value, apply);
+		}
+		return count;
+	}
+
+	/* the names of functions, their arguments, structs and exceptions */
+	if (node->token.type == T_KEYWORD)
+	{
+		switch (node->token.token_code)
+		{
+		case T_FUNCTION:
+			first = 2;
+			break;
+
+		case T_CATCH:
+			first = 1;
+			break;
+
+		case T_STRUCT:
+		case T_NEW:
+			first = node->leaf_count;
+			break;
+
+		default:
+			break;
+		}
+	}
+	else if (node->token.type == T_SYMBOL)
+	{
+		if (jep_is_assignment(node))
+		{
+			first = 1;
+		}
+		else if (node->token.token_code == T_DOUBLECOLON)
+		{
+			first = node->leaf_count;
+		}
+		else if (node->token.token_code == T_PERIOD && node->leaf_count == 2)
+		{
+			/* the name of a data member is not a variable */
+			return jep_propagate(&(node->leaves[0]), name, value, bound, apply);
+		}
+		else if (node->leaf_count == 2
+			&& (node->token.token_code == T_LSQUARE
+				|| (node->token.token_code == T_LPAREN && node->token.postfix)))
+		{
+			/* an array that is subscripted or a function that is called */
+			return jep_propagate(&(node->leaves[0]), name, value, bound, apply)
+				+ jep_propagate(&(node->leaves[1]), name, value, 1, apply);
+		}
+		else if (node->leaf_count == 1 && node->token.token_code == T_LPAREN
+			&& node->token.postfix)
+		{
+			first = 1;
+		}
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		count += jep_propagate(&(node->leaves[i]), name, value,
+			bound || i < first, apply);
+	}
+
+	return count;
+}
+
+/* remembers the values of the const globals declared by a statement */
+static void jep_add_constants(jep_optimizer *opt, jep_ast_node *node)
+{
+	if (node->token.token_code == T_COMMA && node->leaf_count == 2)
+	{
+		jep_add_constants(opt, &(node->leaves[0]));
+		jep_add_constants(opt, &(node->leaves[1]));
+		return;
+	}
+
+	if (node->token.token_code != T_EQUALS || node->leaf_count != 2
+		|| node->leaves[0].token.type != T_IDENTIFIER
+		|| !jep_is_literal(&(node->leaves[1])))
+	{
+		return;
+	}
+
+	const char *name = node->leaves[0].token.val->buffer;
+
+	/* the declaration must be the only place the name is bound */
+	if (jep_propagate(opt->root, name, NULL, 0, 0) != 1)
+	{
+		return;
+	}
+
+	if (opt->size == opt->cap)
+	{
+		opt->cap = opt->cap ? opt->cap * 2 : 8;
+		opt->names = realloc(opt->names, opt->cap * sizeof(const char *));
+		opt->values = realloc(opt->values, opt->cap * sizeof(jep_ast_node));
+	}
+
+	opt->names[opt->size] = name;
+	opt->values[opt->size] = node->leaves[1];
+	opt->size++;
+}
+
+/* simplifies an AST before it is run */
+void jep_optimize(jep_ast_node *root, jep_token_stream *ts, jep_obj *constants)
+{
+	jep_optimizer opt;
+	int i;
+	int j;
+
+	opt.ts = ts;
+	opt.constants = constants;
+	opt.root = root;
+	opt.names = NULL;
+	opt.values = NULL;
+	opt.size = 0;
+	opt.cap = 0;
+
+	i = 0;
+	while (i < root->leaf_count)
+	{
+		jep_ast_node *stm = &(root->leaves[i]);
+
+		/* the const globals that were declared before the statement */
+		for (j = 0; j < opt.size; j++)
+		{
+			jep_propagate(stm, opt.names[j], &(opt.values[j]), 0, 1);
+		}
+
+		if (jep_optimize_node(&opt, stm) == JEP_REMOVE)
+		{
+			jep_free_leaves(stm);
+			for (j = i + 1; j < root->leaf_count; j++)
+			{
+				root->leaves[j - 1] = root->leaves[j];
+			}
+			root->leaf_count--;
+			continue;
+		}
+
+		if (stm->token.type == T_MODIFIER && stm->mod & MOD_CONST
+			&& stm->leaf_count > 0)
+		{
+			jep_add_constants(&opt, &(stm->leaves[stm->leaf_count - 1]));
+		}
+
+		i++;
+	}
+
+	free(opt.names);
+	free(opt.values);
+}
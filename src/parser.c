@@ -1065,6 +1065,15 @@ void jep_parse(jep_token_stream *ts, jep_ast_node *root)
 		nodes[i].array = 0;
 		nodes[i].loop = 0;
 		nodes[i].mod = 0;
+		nodes[i].code = NULL;
+		nodes[i].slot = -1;
+		nodes[i].slots = 0;
+		nodes[i].target = 0;
+		nodes[i].value = NULL;
+		nodes[i].shape = NULL;
+		nodes[i].member = -1;
+		nodes[i].quick = 0;
+		nodes[i].cases = NULL;
 	}
 
 	first = nodes;
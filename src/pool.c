@@ -0,0 +1,193 @@
+/*
+	Functions for allocating small blocks of memory from slabs
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include "swap/pool.h"
+
+/* an unused block in a free list */
+typedef struct Block
+{
+	struct Block *next;
+} jep_block;
+
+/* the header at the beginning of each slab */
+typedef struct Slab
+{
+	struct Slab *next;
+} jep_slab;
+
+/*
+ * the free lists, slabs and statistics of the allocator.
+ * swap code is only run by the main thread, so there is a single
+ * cache. if threads are ever able to run swap code, this should
+ * become one cache per thread.
+ */
+typedef struct Pool
+{
+	jep_block *free[JEP_POOL_CLASSES];            /* free blocks of each size  */
+	jep_slab *slabs;                              /* all slabs                 */
+	jep_pool_stats stats[JEP_POOL_CLASSES + 1];   /* the last is for malloc    */
+	jep_pool_stats all;                           /* all blocks                */
+} jep_pool;
+
+static jep_pool pool;
+
+/* updates the statistics after a block has been allocated */
+static void jep_count_alloc(jep_pool_stats *stats)
+{
+	stats->total++;
+	if (++(stats->live) > stats->peak)
+	{
+		stats->peak = stats->live;
+	}
+}
+
+/* carves a new slab into blocks of a size class */
+static jep_block *jep_create_slab(int c)
+{
+	size_t size = (c + 1) * JEP_POOL_ALIGN;
+	char *slab = malloc(JEP_SLAB_SIZE);
+	char *block;
+	char *end = slab + JEP_SLAB_SIZE - size;
+	jep_block *head = NULL;
+
+	if (slab == NULL)
+	{
+		return NULL;
+	}
+
+	((jep_slab *)slab)->next = pool.slabs;
+	pool.slabs = (jep_slab *)slab;
+
+	/* link the blocks in address order */
+	for (block = end; block >= slab + JEP_POOL_ALIGN; block -= size)
+	{
+		((jep_block *)block)->next = head;
+		head = (jep_block *)block;
+	}
+
+	return head;
+}
+
+/* allocates a block of memory */
+void *jep_pool_alloc(size_t size)
+{
+	jep_block *block;
+	int c;
+
+	if (size == 0 || size > JEP_POOL_MAX)
+	{
+		jep_count_alloc(&(pool.stats[JEP_POOL_CLASSES]));
+		jep_count_alloc(&(pool.all));
+		return malloc(size);
+	}
+
+	c = (int)((size - 1) / JEP_POOL_ALIGN);
+	block = pool.free[c];
+
+	if (block == NULL)
+	{
+		block = jep_create_slab(c);
+		if (block == NULL)
+		{
+			return NULL;
+		}
+	}
+
+	pool.free[c] = block->next;
+	jep_count_alloc(&(pool.stats[c]));
+	jep_count_alloc(&(pool.all));
+
+	return block;
+}
+
+/* returns a block of memory to the free list of its size */
+void jep_pool_free(void *block, size_t size)
+{
+	int c;
+
+	if (block == NULL)
+	{
+		return;
+	}
+
+	pool.all.live--;
+
+	if (size == 0 || size > JEP_POOL_MAX)
+	{
+		pool.stats[JEP_POOL_CLASSES].live--;
+		free(block);
+		return;
+	}
+
+	c = (int)((size - 1) / JEP_POOL_ALIGN);
+	((jep_block *)block)->next = pool.free[c];
+	pool.free[c] = (jep_block *)block;
+	pool.stats[c].live--;
+}
+
+/* gets the allocation statistics of all blocks */
+jep_pool_stats jep_get_pool_stats()
+{
+	return pool.all;
+}
+
+/* writes the allocation statistics of each block size to standard out */
+void jep_print_pool_stats()
+{
+	int c;
+
+	printf("%8s %10s %10s %10s\n", "size", "live", "peak", "total");
+	for (c = 0; c <= JEP_POOL_CLASSES; c++)
+	{
+		jep_pool_stats *s = &(pool.stats[c]);
+		if (s->total > 0)
+		{
+			if (c < JEP_POOL_CLASSES)
+			{
+				printf("%8d", (c + 1) * JEP_POOL_ALIGN);
+			}
+			else
+			{
+				printf("%8s", "large");
+			}
+			printf(" %10ld %10ld %10ld\n", s->live, s->peak, s->total);
+		}
+	}
+	printf("%8s %10ld %10ld %10ld\n", "all",
+		pool.all.live, pool.all.peak, pool.all.total);
+}
+
+/* frees the memory used by all slabs */
+void jep_destroy_pool()
+{
+	jep_slab *slab = pool.slabs;
+	int c;
+
+	while (slab != NULL)
+	{
+		jep_slab *next = slab->next;
+		free(slab);
+		slab = next;
+	}
+
+	pool.slabs = NULL;
+	for (c = 0; c < JEP_POOL_CLASSES; c++)
+	{
+		pool.free[c] = NULL;
+	}
+}
@@ -0,0 +1,790 @@
+/*
+	Functions for binding identifiers to the slots of function frames
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <stdlib.h>
+#include "swap/resolver.h"
+
+/*
+ * Swap is dynamically scoped, so a function can see the variables of
+ * the function that called it. Only the names that are declared in the
+ * function's own frame can be bound to a slot: its arguments and the
+ * local variables declared directly in its body. A name is only bound if
+ * nothing else in the function could declare another object with the
+ * same name, otherwise it is left to be looked up by name at runtime.
+ */
+
+/* the names that occupy the slots of a function's frame */
+typedef struct Resolver
+{
+	const char **names; /* identifiers of the slots            */
+	int *decls;         /* number of declarations of each name */
+	int size;           /* number of slots                     */
+	int cap;            /* capacity                            */
+}jep_resolver;
+
+/* gets the slot of a name */
+static int jep_find_slot(jep_resolver *r, const char *name)
+{
+	int i;
+
+	for (i = 0; i < r->size; i++)
+	{
+		if (r->names[i] == name)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* adds a name to the frame if it doesn't already have a slot */
+static int jep_add_slot(jep_resolver *r, const char *name)
+{
+	int slot = jep_find_slot(r, name);
+
+	if (slot >= 0)
+	{
+		return slot;
+	}
+
+	if (r->size == r->cap)
+	{
+		r->cap = r->cap == 0 ? 8 : r->cap + r->cap / 2;
+		r->names = realloc(r->names, r->cap * sizeof(const char *));
+		r->decls = realloc(r->decls, r->cap * sizeof(int));
+	}
+
+	r->names[r->size] = name;
+	r->decls[r->size] = 0;
+
+	return r->size++;
+}
+
+/* counts a declaration of a name */
+static void jep_count_decl(jep_resolver *r, const char *name)
+{
+	int slot = jep_find_slot(r, name);
+
+	if (slot >= 0)
+	{
+		r->decls[slot]++;
+	}
+}
+
+/* applies a function to each identifier declared by a modifier */
+static void jep_modified_names(jep_resolver *r, jep_ast_node *exp,
+	void (*f)(jep_resolver *, const char *))
+{
+	if (exp->token.token_code == T_COMMA && exp->leaf_count == 2)
+	{
+		jep_modified_names(r, &(exp->leaves[0]), f);
+		jep_modified_names(r, &(exp->leaves[1]), f);
+	}
+	else if (exp->token.token_code == T_EQUALS && exp->leaf_count == 2)
+	{
+		if (exp->leaves[0].token.type == T_IDENTIFIER)
+		{
+			f(r, exp->leaves[0].token.val->buffer);
+		}
+	}
+	else if (exp->token.type == T_IDENTIFIER)
+	{
+		f(r, exp->token.val->buffer);
+	}
+}
+
+/* registers the name of a local variable */
+static void jep_local_name(jep_resolver *r, const char *name)
+{
+	jep_add_slot(r, name);
+}
+
+/* counts every declaration made in the body of a function */
+static void jep_count_decls(jep_resolver *r, jep_ast_node *node)
+{
+	int i;
+
+	if (node->token.type == T_MODIFIER && node->leaf_count > 0)
+	{
+		jep_modified_names(r, &(node->leaves[node->leaf_count - 1]),
+			jep_count_decl);
+	}
+	else if (node->token.type == T_KEYWORD && node->leaf_count > 0)
+	{
+		if (node->token.token_code == T_FUNCTION)
+		{
+			/* nested functions have their own frames */
+			jep_count_decl(r, node->leaves[0].token.val->buffer);
+			return;
+		}
+		else if (node->token.token_code == T_STRUCT)
+		{
+			jep_count_decl(r, node->leaves[0].token.val->buffer);
+			return;
+		}
+		else if (node->token.token_code == T_CATCH)
+		{
+			jep_count_decl(r, node->leaves[0].token.val->buffer);
+		}
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_count_decls(r, &(node->leaves[i]));
+	}
+}
+
+/* binds the identifiers of a function body to their slots */
+static void jep_bind_slots(jep_resolver *r, jep_ast_node *node)
+{
+	int i;
+
+	if (node->token.type == T_IDENTIFIER)
+	{
+		int slot = jep_find_slot(r, node->token.val->buffer);
+
+		if (slot >= 0 && r->decls[slot] == 1)
+		{
+			node->slot = slot;
+		}
+	}
+	else if (node->token.type == T_KEYWORD
+		&& (node->token.token_code == T_FUNCTION
+			|| node->token.token_code == T_STRUCT))
+	{
+		return;
+	}
+	else if (node->token.token_code == T_PERIOD && node->leaf_count == 2)
+	{
+		/* data members are not variables */
+		jep_bind_slots(r, &(node->leaves[0]));
+		return;
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_bind_slots(r, &(node->leaves[i]));
+	}
+}
+
+/*
+ * marks the returns in a function that return a call to the same
+ * function. a call in a try block has to happen inside of it in case
+ * it throws an exception, so the returns in a try block aren't marked.
+ */
+static void jep_mark_tail_calls(jep_ast_node *node, const char *name)
+{
+	int i;
+
+	if (node->token.type == T_KEYWORD
+		&& (node->token.token_code == T_TRY
+			|| node->token.token_code == T_FUNCTION))
+	{
+		return;
+	}
+
+	if (node->token.type == T_KEYWORD && node->token.token_code == T_RETURN)
+	{
+		jep_ast_node *call = &(node->leaves[0]);
+		if (node->leaf_count == 1 && call->token.token_code == T_LPAREN
+			&& call->token.postfix
+			&& (call->leaf_count == 1 || call->leaf_count == 2)
+			&& call->leaves[call->leaf_count - 1].token.type == T_IDENTIFIER
+			&& call->leaves[call->leaf_count - 1].token.val->buffer == name)
+		{
+			node->loop |= JEP_TAIL;
+		}
+		return;
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_mark_tail_calls(&(node->leaves[i]), name);
+	}
+}
+
+/* binds the arguments and local variables of a function */
+static void jep_resolve_function(jep_ast_node *node)
+{
+	jep_resolver r;
+	jep_ast_node *args = &(node->leaves[1]);
+	jep_ast_node *body = &(node->leaves[2]);
+	int i;
+
+	r.names = NULL;
+	r.decls = NULL;
+	r.size = 0;
+	r.cap = 0;
+
+	/* arguments occupy the first slots in the order they are passed */
+	for (i = 0; i < args->leaf_count; i++)
+	{
+		int slot = jep_add_slot(&r, args->leaves[i].token.val->buffer);
+		r.decls[slot]++;
+	}
+
+	/* local variables declared directly in the body are added to the frame */
+	for (i = 0; i < body->leaf_count; i++)
+	{
+		jep_ast_node *stmt = &(body->leaves[i]);
+		if (stmt->token.type == T_MODIFIER && stmt->leaf_count > 0)
+		{
+			jep_modified_names(&r, &(stmt->leaves[stmt->leaf_count - 1]),
+				jep_local_name);
+		}
+	}
+
+	jep_count_decls(&r, body);
+
+	jep_bind_slots(&r, body);
+
+	body->slots = r.size;
+
+	jep_mark_tail_calls(body, node->leaves[0].token.val->buffer);
+
+	free(r.names);
+	free(r.decls);
+}
+
+/*
+ * marks the subscripts and data member accesses that an element is
+ * written through, so that a shared array or struct is only copied
+ * when it is about to be modified
+ */
+static void jep_mark_target(jep_ast_node *node)
+{
+	if (node->token.token_code == T_LSQUARE && node->leaf_count == 2)
+	{
+		node->target = 1;
+		jep_mark_target(&(node->leaves[1]));
+	}
+	else if (node->token.token_code == T_PERIOD && node->leaf_count == 2)
+	{
+		node->target = 1;
+		jep_mark_target(&(node->leaves[0]));
+	}
+	else if (node->token.token_code == T_LPAREN && !node->token.postfix
+		&& node->leaf_count == 1)
+	{
+		jep_mark_target(&(node->leaves[0]));
+	}
+}
+
+/* checks if a node modifies its first operand */
+static int jep_is_assignment(jep_ast_node *node)
+{
+	if (node->token.type != T_SYMBOL || node->leaf_count < 1)
+	{
+		return 0;
+	}
+
+	switch (node->token.token_code)
+	{
+	case T_EQUALS:
+	case T_ADDASSIGN:
+	case T_SUBASSIGN:
+	case T_MULASSIGN:
+	case T_DIVASSIGN:
+	case T_MODASSIGN:
+	case T_ANDASSIGN:
+	case T_ORASSIGN:
+	case T_XORASSIGN:
+	case T_LSHIFTASSIGN:
+	case T_RSHIFTASSIGN:
+	case T_INCREMENT:
+	case T_DECREMENT:
+	case T_COLON:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+/*
+ * checks if evaluating a node could add an object to the innermost scope.
+ * an assignment to a name that isn't bound to a slot may create the
+ * object, since there is no way to know whether it already exists.
+ */
+int jep_declares(jep_ast_node *node)
+{
+	int i;
+
+	if (node->token.type == T_MODIFIER)
+	{
+		return 1;
+	}
+	else if (node->token.type == T_KEYWORD
+		&& (node->token.token_code == T_FUNCTION
+			|| node->token.token_code == T_STRUCT))
+	{
+		return 1;
+	}
+	else if (jep_is_assignment(node)
+		&& node->token.token_code != T_INCREMENT
+		&& node->token.token_code != T_DECREMENT
+		&& node->leaves[0].token.type == T_IDENTIFIER
+		&& node->leaves[0].slot < 0)
+	{
+		return 1;
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		if (jep_declares(&(node->leaves[i])))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * marks the target of an assignment that is evaluated as a statement,
+ * since the value of the assignment is never used
+ */
+static void jep_mark_discarded(jep_ast_node *node)
+{
+	if (node->token.type == T_SYMBOL && node->token.token_code == T_EQUALS
+		&& node->leaf_count == 2
+		&& node->leaves[0].token.type == T_IDENTIFIER)
+	{
+		node->leaves[0].loop |= JEP_DISCARDED;
+	}
+}
+
+/* marks the assignments evaluated as the statements of a node */
+static void jep_mark_statements(jep_ast_node *node)
+{
+	jep_ast_node *head;
+	int i;
+
+	if (node->token.token_code == T_LBRACE && !node->array)
+	{
+		for (i = 0; i < node->leaf_count; i++)
+		{
+			jep_mark_discarded(&(node->leaves[i]));
+		}
+	}
+	else if (node->token.type != T_KEYWORD || node->leaf_count < 2)
+	{
+		if (node->token.token_code == T_ELSE && node->leaf_count == 1)
+		{
+			jep_mark_discarded(&(node->leaves[0]));
+		}
+	}
+	else if (node->token.token_code == T_IF
+		|| node->token.token_code == T_WHILE)
+	{
+		jep_mark_discarded(&(node->leaves[1]));
+	}
+	else if (node->token.token_code == T_FOR)
+	{
+		head = &(node->leaves[0]);
+		jep_mark_discarded(&(node->leaves[1]));
+		if (node->loop & JEP_INDEX && head->leaf_count > 0)
+		{
+			jep_mark_discarded(&(head->leaves[0]));
+		}
+		if (node->loop & JEP_CHANGE && head->leaf_count > 0)
+		{
+			jep_mark_discarded(&(head->leaves[head->leaf_count - 1]));
+		}
+	}
+}
+
+/* marks a loop that never adds anything to the scope of an iteration */
+static void jep_resolve_loop(jep_ast_node *node)
+{
+	jep_ast_node *head = &(node->leaves[0]);
+	int i = 0;
+
+	/* the index of a for loop is evaluated before the first iteration */
+	if (node->token.token_code == T_FOR && node->loop & JEP_INDEX)
+	{
+		i = 1;
+	}
+
+	for (; i < head->leaf_count; i++)
+	{
+		if (jep_declares(&(head->leaves[i])))
+		{
+			return;
+		}
+	}
+
+	if (node->leaf_count == 2 && jep_declares(&(node->leaves[1])))
+	{
+		return;
+	}
+
+	node->loop |= JEP_UNSCOPED;
+}
+
+/*
+ * marks a for loop that counts an index up to a limit.
+ * the increment and the condition of such a loop can be done in place
+ * while the index and the limit are ints.
+ */
+static void jep_resolve_count(jep_ast_node *node)
+{
+	jep_ast_node *head = &(node->leaves[0]);
+	jep_ast_node *cond;
+	jep_ast_node *change;
+
+	if ((node->loop & (JEP_INDEX | JEP_CONDITION | JEP_CHANGE))
+		!= (JEP_INDEX | JEP_CONDITION | JEP_CHANGE))
+	{
+		return;
+	}
+
+	cond = &(head->leaves[1]);
+	change = &(head->leaves[2]);
+
+	if (cond->token.token_code != T_LESS || cond->leaf_count != 2
+		|| cond->leaves[0].token.type != T_IDENTIFIER
+		|| (cond->leaves[1].token.type != T_IDENTIFIER
+			&& cond->leaves[1].token.type != T_NUMBER))
+	{
+		return;
+	}
+
+	if (change->token.token_code != T_INCREMENT || change->leaf_count != 1
+		|| change->leaves[0].token.type != T_IDENTIFIER
+		|| change->leaves[0].token.val->buffer
+			!= cond->leaves[0].token.val->buffer)
+	{
+		return;
+	}
+
+	node->loop |= JEP_COUNTED;
+}
+
+/* the largest range of labels that always gets a jump table */
+#define JEP_CASE_RANGE 256
+
+/* the number of entries per label allowed in a larger jump table */
+#define JEP_CASE_SPREAD 4
+
+/* gets the value of an int, char or byte label as an index */
+static int jep_case_key(jep_obj *value)
+{
+	switch (value->type)
+	{
+	case JEP_INT:
+		return *(int *)(value->val);
+
+	case JEP_CHARACTER:
+		return *(char *)(value->val);
+
+	default:
+		return *(unsigned char *)(value->val);
+	}
+}
+
+/* gets the block that is run when a label of a switch matches */
+static jep_ast_node *jep_case_block(jep_ast_node *group)
+{
+	if (group->token.token_code == T_DEFAULT)
+	{
+		return group;
+	}
+
+	return &(group->leaves[group->leaf_count - 1]);
+}
+
+/*
+ * builds the jump table of a switch statement whose case labels are
+ * all literals of the same type. the labels of ints, chars and bytes
+ * index an array of blocks, and strings are found in a hash table.
+ * a label that appears more than once keeps its first block.
+ */
+static void jep_resolve_switch(jep_ast_node *node)
+{
+	jep_ast_node *body = &(node->leaves[1]);
+	jep_case_table *table;
+	int type = 0;
+	int count = 0;
+	long min = 0;
+	long max = 0;
+	int i;
+	int j;
+
+	if (!jep_declares(body))
+	{
+		node->loop |= JEP_UNSCOPED;
+	}
+
+	for (i = 0; i < body->leaf_count; i++)
+	{
+		jep_ast_node *group = &(body->leaves[i]);
+
+		for (j = 0; j < group->leaf_count
+			&& group->token.token_code == T_CASE; j++)
+		{
+			jep_ast_node *label = &(group->leaves[j]);
+			long key;
+
+			if (label->token.token_code == T_DEFAULT)
+			{
+				continue;
+			}
+
+			/* a label that isn't a literal is evaluated every time */
+			if (label->value == NULL || (type && label->value->type != type))
+			{
+				return;
+			}
+
+			type = label->value->type;
+			if (type == JEP_STRING)
+			{
+				count++;
+				continue;
+			}
+			else if (type != JEP_INT && type != JEP_CHARACTER
+				&& type != JEP_BYTE)
+			{
+				return;
+			}
+
+			key = jep_case_key(label->value);
+			if (!count || key < min)
+			{
+				min = key;
+			}
+			if (!count || key > max)
+			{
+				max = key;
+			}
+			count++;
+		}
+	}
+
+	if (!count || (type != JEP_STRING && max - min >= JEP_CASE_RANGE
+		&& max - min >= (long)count * JEP_CASE_SPREAD))
+	{
+		return;
+	}
+
+	table = malloc(sizeof(jep_case_table));
+	table->type = type;
+	table->min = (int)min;
+	table->size = 0;
+	table->blocks = NULL;
+	table->strings = NULL;
+	table->fallback = NULL;
+
+	if (type == JEP_STRING)
+	{
+		table->strings = jep_create_table();
+	}
+	else
+	{
+		table->size = (int)(max - min + 1);
+		table->blocks = calloc(table->size, sizeof(jep_ast_node *));
+	}
+
+	for (i = 0; i < body->leaf_count; i++)
+	{
+		jep_ast_node *group = &(body->leaves[i]);
+		jep_ast_node *block = jep_case_block(group);
+
+		if (group->token.token_code == T_DEFAULT)
+		{
+			table->fallback = block;
+			continue;
+		}
+
+		for (j = 0; j < group->leaf_count; j++)
+		{
+			jep_ast_node *label = &(group->leaves[j]);
+
+			if (label->token.token_code == T_DEFAULT)
+			{
+				table->fallback = block;
+			}
+			else if (type == JEP_STRING)
+			{
+				const char *key = (const char *)(label->value->val);
+				if (jep_table_get(table->strings, key) == NULL)
+				{
+					jep_table_put(table->strings, key, block);
+				}
+			}
+			else
+			{
+				int k = jep_case_key(label->value) - table->min;
+				if (table->blocks[k] == NULL)
+				{
+					table->blocks[k] = block;
+				}
+			}
+		}
+	}
+
+	node->cases = table;
+}
+
+/* finds the block of a switch statement that a value jumps to */
+jep_ast_node *jep_find_case(jep_case_table *table, jep_obj *value)
+{
+	jep_ast_node *block = NULL;
+
+	if (value->type == table->type)
+	{
+		if (table->strings != NULL)
+		{
+			block = jep_table_get(table->strings, (const char *)(value->val));
+		}
+		else
+		{
+			long k = (long)jep_case_key(value) - table->min;
+			if (k >= 0 && k < table->size)
+			{
+				block = table->blocks[k];
+			}
+		}
+	}
+
+	return block != NULL ? block : table->fallback;
+}
+
+/* frees the jump tables of the switch statements in an AST */
+void jep_destroy_cases(jep_ast_node *node)
+{
+	int i;
+
+	if (node->cases != NULL)
+	{
+		jep_destroy_table(node->cases->strings);
+		free(node->cases->blocks);
+		free(node->cases);
+		node->cases = NULL;
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_destroy_cases(&(node->leaves[i]));
+	}
+}
+
+/* finds every function definition, assignment and loop in an AST */
+static void jep_resolve_node(jep_ast_node *node)
+{
+	int i;
+
+	if (jep_is_assignment(node))
+	{
+		jep_mark_target(&(node->leaves[0]));
+	}
+
+	jep_mark_statements(node);
+
+	/* a loop is reached after the identifiers of its function are bound */
+	if (node->token.type == T_KEYWORD && node->leaf_count > 0
+		&& (node->token.token_code == T_FOR
+			|| node->token.token_code == T_WHILE))
+	{
+		jep_resolve_loop(node);
+	}
+
+	if (node->token.type == T_KEYWORD && node->token.token_code == T_FOR
+		&& node->leaf_count > 0)
+	{
+		jep_resolve_count(node);
+	}
+
+	if (node->token.type == T_KEYWORD && node->token.token_code == T_SWITCH
+		&& node->leaf_count == 2 && node->cases == NULL)
+	{
+		jep_resolve_switch(node);
+	}
+
+	if (node->token.type == T_KEYWORD && node->token.token_code == T_FUNCTION
+		&& node->leaf_count == 3 && node->leaves[2].token.token_code == T_LBRACE)
+	{
+		jep_resolve_function(node);
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		jep_resolve_node(&(node->leaves[i]));
+	}
+}
+
+/*
+ * binds the arguments and local variables of each function in an AST,
+ * marks the targets of assignments and the assignments whose values
+ * are discarded, marks the unscoped and counted loops, marks the
+ * tail calls and builds the jump tables of switch statements
+ */
+void jep_resolve(jep_ast_node *root)
+{
+	int i;
+
+	/* the statements at the top level */
+	for (i = 0; i < root->leaf_count; i++)
+	{
+		jep_mark_discarded(&(root->leaves[i]));
+	}
+
+	jep_resolve_node(root);
+}
+
+/* adds the literals of an AST to the constant pool */
+static int jep_pool_node(jep_ast_node *node, jep_obj *pool)
+{
+	int i;
+
+	if (node->token.type == T_NUMBER || node->token.type == T_CHARACTER
+		|| node->token.type == T_STRING)
+	{
+		node->value = jep_constant(node);
+		if (node->value == NULL)
+		{
+			return 0;
+		}
+		jep_add_object(pool, node->value);
+	}
+
+	for (i = 0; i < node->leaf_count; i++)
+	{
+		if (!jep_pool_node(&(node->leaves[i]), pool))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* converts each literal in an AST into a value in the constant pool */
+jep_obj *jep_create_constants(jep_ast_node *root)
+{
+	jep_obj *pool = jep_create_object();
+	pool->type = JEP_LIST;
+
+	if (!jep_pool_node(root, pool))
+	{
+		root->error = 1;
+	}
+
+	return pool;
+}
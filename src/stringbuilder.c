@@ -15,8 +15,12 @@
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <string.h>
 #include "swap/stringbuilder.h"
 
+/* the smallest number of characters read from a file at once */
+#define JEP_SCAN_BLOCK 4096
+
 /**
  * allocates memory for a StringBuilder
  */
@@ -66,30 +70,48 @@ void jep_append_char(jep_string_builder *sb, char c)
 	sb->buffer[sb->size] = '\0';
 }
 
+/**
+ * makes room for a number of characters after the end of a
+ * StringBuilder's buffer
+ */
+static void jep_reserve(jep_string_builder *sb, int n)
+{
+	if (sb->size + n >= sb->cap)
+	{
+		int new_cap = sb->cap + sb->cap / 2;
+		if (new_cap < sb->size + n + 1)
+		{
+			new_cap = sb->size + n + 1;
+		}
+		sb->buffer = realloc(sb->buffer, new_cap);
+		sb->cap = new_cap;
+	}
+}
+
 /**
  * adds a null-terminated C string to a StringBuilder's buffer
  */
 void jep_append_string(jep_string_builder *sb, const char *str)
 {
-	int i = 0;
-	while (str[i] != '\0')
-		jep_append_char(sb, str[i++]);
+	int n = (int)strlen(str);
+
+	jep_reserve(sb, n);
+	memcpy(sb->buffer + sb->size, str, n + 1);
+	sb->size += n;
 }
 
 /**
- * reads the contents of a file into memory
+ * reads the contents of a file into memory.
+ * each block is read straight into the buffer.
  */
 void jep_scan_file(FILE *file, jep_string_builder *sb)
 {
-	char buffer[1025];
 	size_t s;
 	do
 	{
-		s = fread(buffer, 1, 1024, file);
-		if (s > 0)
-		{
-			buffer[s] = '\0';
-			jep_append_string(sb, buffer);
-		}
+		jep_reserve(sb, JEP_SCAN_BLOCK);
+		s = fread(sb->buffer + sb->size, 1, sb->cap - sb->size - 1, file);
+		sb->size += (int)s;
+		sb->buffer[sb->size] = '\0';
 	} while (s > 0);
 }
@@ -0,0 +1,166 @@
+/*
+	A hash table that maps identifiers to values
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "swap/table.h"
+
+/* initial number of entries */
+#define JEP_TABLE_CAP 64
+
+/* finds the entry of a key, or the empty entry where it belongs */
+static jep_entry *jep_find_entry(jep_entry *entries, int cap,
+	const char *key, int len, unsigned int hash)
+{
+	unsigned int i = hash & (cap - 1);
+
+	while (entries[i].key != NULL)
+	{
+		if (entries[i].hash == hash && entries[i].len == len
+			&& (entries[i].key == key || !memcmp(entries[i].key, key, len)))
+		{
+			break;
+		}
+		i = (i + 1) & (cap - 1);
+	}
+
+	return &(entries[i]);
+}
+
+/* doubles the number of entries in a table */
+static void jep_grow_table(jep_table *table)
+{
+	int cap = table->cap * 2;
+	jep_entry *entries = calloc(cap, sizeof(jep_entry));
+	int i;
+
+	for (i = 0; i < table->cap; i++)
+	{
+		jep_entry *e = &(table->entries[i]);
+		if (e->key != NULL)
+		{
+			*jep_find_entry(entries, cap, e->key, e->len, e->hash) = *e;
+		}
+	}
+
+	free(table->entries);
+	table->entries = entries;
+	table->cap = cap;
+}
+
+/**
+ * allocates memory for a new hash table
+ */
+jep_table *jep_create_table()
+{
+	jep_table *table = malloc(sizeof(jep_table));
+	table->size = 0;
+	table->cap = JEP_TABLE_CAP;
+	table->entries = calloc(table->cap, sizeof(jep_entry));
+	return table;
+}
+
+/**
+ * frees the memory used by a hash table
+ */
+void jep_destroy_table(jep_table *table)
+{
+	if (table == NULL)
+	{
+		return;
+	}
+
+	free(table->entries);
+	free(table);
+}
+
+/**
+ * computes the hash code of an identifier (FNV-1a)
+ */
+unsigned int jep_hash(const char *key)
+{
+	return jep_hash_slice(key, (int)strlen(key));
+}
+
+/**
+ * computes the hash code of some characters (FNV-1a)
+ */
+unsigned int jep_hash_slice(const char *key, int len)
+{
+	unsigned int hash = 2166136261u;
+	int i;
+
+	for (i = 0; i < len; i++)
+	{
+		hash ^= (unsigned char)key[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * retreives the value associated with a key
+ */
+void *jep_table_get(jep_table *table, const char *key)
+{
+	return jep_table_get_slice(table, key, (int)strlen(key));
+}
+
+/**
+ * associates a value with a key, replacing any previous value
+ */
+void jep_table_put(jep_table *table, const char *key, void *val)
+{
+	jep_table_put_slice(table, key, (int)strlen(key), val);
+}
+
+/**
+ * retreives the value associated with a key of some length
+ */
+void *jep_table_get_slice(jep_table *table, const char *key, int len)
+{
+	unsigned int hash = jep_hash_slice(key, len);
+	jep_entry *e = jep_find_entry(table->entries, table->cap, key, len, hash);
+
+	return e->val;
+}
+
+/**
+ * associates a value with a key of some length
+ */
+void jep_table_put_slice(jep_table *table, const char *key, int len,
+	void *val)
+{
+	unsigned int hash = jep_hash_slice(key, len);
+	jep_entry *e = jep_find_entry(table->entries, table->cap, key, len, hash);
+
+	if (e->key == NULL)
+	{
+		/* keep the load factor below three quarters */
+		if ((table->size + 1) * 4 > table->cap * 3)
+		{
+			jep_grow_table(table);
+			e = jep_find_entry(table->entries, table->cap, key, len, hash);
+		}
+		e->key = key;
+		e->len = len;
+		e->hash = hash;
+		table->size++;
+	}
+
+	e->val = val;
+}
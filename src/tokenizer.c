@@ -18,39 +18,6 @@
 #include "swap/tokenizer.h"
 #include "swap/import.h"
 
-/**
- * one-character symbols
- */
-const char *symbols[] =
-{
-	"+", "-", "/", "*", ";", ",", "(", ")", "[", "]", "{",
-	"}", "<", ">", "=", ".", "&", "|", "^", "!", "%", ":" };
-
-/**
- * two-character symbols
- */
-const char *symbols2[] =
-{
-	"++", "--", "+=", "-=", "*=", "/=", "%=", "==", "<=",
-	">=", ">>", "<<", "&=", "|=", "^=", "&&", "||", "!=",
-	"::" };
-
-/**
- * three-character symbols
- */
-const char *symbols3[] =
-{
-	"<<=", ">>=" };
-
-/**
- * keywords
- */
-const char *keywords[] =
-{
-	"if", "else", "for", "while", "function", "return", "import", "null",
-	"struct", "local", "const", "new", "try", "catch", "throw", "switch",
-	"case", "break", "default" };
-
 /**
  * escape characters
  */
@@ -74,104 +41,191 @@ static int jep_is_escape(char c)
 	return -1;
 }
 
+/* matches the text of a keyword */
+#define JEP_KEYWORD(word, code) \
+	if (len == sizeof(word) - 1 && !memcmp(s, word, len)) return code
+
 /**
- * checks for a symbol character
+ * gets the token code of a keyword, or 0 if the text is not a keyword.
+ * the first character selects the few keywords that it can begin.
  */
-static int jep_is_symbol_char(char c)
+static int jep_keyword(const char *s, int len)
 {
-	switch (c)
+	switch (s[0])
 	{
-	case '+':
-	case '-':
-	case '*':
-	case '/':
-	case '<':
-	case '>':
-	case '!':
-	case '=':
-	case '.':
-	case ',':
-	case ';':
-	case '(':
-	case ')':
-	case '{':
-	case '}':
-	case '[':
-	case ']':
-	case '&':
-	case '|':
-	case '^':
-	case '%':
-	case ':':
-		return 1;
+	case 'b':
+		JEP_KEYWORD("break", T_BREAK);
+		break;
+
+	case 'c':
+		JEP_KEYWORD("case", T_CASE);
+		JEP_KEYWORD("catch", T_CATCH);
+		JEP_KEYWORD("const", T_CONST);
+		break;
+
+	case 'd':
+		JEP_KEYWORD("default", T_DEFAULT);
+		break;
+
+	case 'e':
+		JEP_KEYWORD("else", T_ELSE);
+		break;
+
+	case 'f':
+		JEP_KEYWORD("for", T_FOR);
+		JEP_KEYWORD("function", T_FUNCTION);
+		break;
+
+	case 'i':
+		JEP_KEYWORD("if", T_IF);
+		JEP_KEYWORD("import", T_IMPORT);
+		break;
+
+	case 'l':
+		JEP_KEYWORD("local", T_LOCAL);
+		break;
+
+	case 'n':
+		JEP_KEYWORD("new", T_NEW);
+		JEP_KEYWORD("null", T_NULL);
+		break;
+
+	case 'r':
+		JEP_KEYWORD("return", T_RETURN);
+		break;
+
+	case 's':
+		JEP_KEYWORD("struct", T_STRUCT);
+		JEP_KEYWORD("switch", T_SWITCH);
+		break;
+
+	case 't':
+		JEP_KEYWORD("try", T_TRY);
+		JEP_KEYWORD("throw", T_THROW);
+		break;
+
+	case 'w':
+		JEP_KEYWORD("while", T_WHILE);
+		break;
+
 	default:
-		return 0;
+		break;
 	}
-}
 
-/**
- * checks for a single-character symbol
- */
-static int jep_is_symbol(const char *s)
-{
-	int i;
-	for (i = 0; i < 22; i++)
-	{
-		if (!strcmp(symbols[i], s))
-		{
-			return i;
-		}
-	}
-	return -1;
+	return 0;
 }
 
-/**
- * checks for a double-character symbol
- */
-static int jep_is_symbol2(const char *s)
-{
-	int i;
-	for (i = 0; i < 19; i++)
-	{
-		if (!strcmp(symbols2[i], s))
-		{
-			return i;
-		}
-	}
-	return -1;
-}
+/* chooses between the symbols that continue with a certain character */
+#define JEP_NEXT(c, code, n) \
+	if (s[1] == c) { *len = n; return code; }
 
 /**
- * checks for a tripple-character symbol
+ * gets the token code of the longest symbol at the beginning of some
+ * text and its number of characters, or 0 if there isn't a symbol.
  */
-static int jep_is_symbol3(const char *s)
+static int jep_symbol(const char *s, int *len)
 {
-	int i;
-	for (i = 0; i < 2; i++)
+	*len = 1;
+
+	switch (s[0])
 	{
-		if (!strcmp(symbols3[i], s))
+	case '+':
+		JEP_NEXT('+', T_INCREMENT, 2);
+		JEP_NEXT('=', T_ADDASSIGN, 2);
+		return T_PLUS;
+
+	case '-':
+		JEP_NEXT('-', T_DECREMENT, 2);
+		JEP_NEXT('=', T_SUBASSIGN, 2);
+		return T_MINUS;
+
+	case '*':
+		JEP_NEXT('=', T_MULASSIGN, 2);
+		return T_STAR;
+
+	case '/':
+		JEP_NEXT('=', T_DIVASSIGN, 2);
+		return T_FSLASH;
+
+	case '%':
+		JEP_NEXT('=', T_MODASSIGN, 2);
+		return T_MODULUS;
+
+	case '=':
+		JEP_NEXT('=', T_EQUIVALENT, 2);
+		return T_EQUALS;
+
+	case '!':
+		JEP_NEXT('=', T_NOTEQUIVALENT, 2);
+		return T_NOT;
+
+	case '<':
+		if (s[1] == '<')
 		{
-			return i;
+			*len = s[2] == '=' ? 3 : 2;
+			return s[2] == '=' ? T_LSHIFTASSIGN : T_LSHIFT;
 		}
-	}
-	return -1;
-}
+		JEP_NEXT('=', T_LOREQUAL, 2);
+		return T_LESS;
 
-/**
- * checks for a keyword
- */
-static int jep_is_keyword(const char *s)
-{
-	int i;
-	for (i = 0; i < 19; i++)
-	{
-		if (!strcmp(s, keywords[i]))
+	case '>':
+		if (s[1] == '>')
 		{
-			return i;
+			*len = s[2] == '=' ? 3 : 2;
+			return s[2] == '=' ? T_RSHIFTASSIGN : T_RSHIFT;
 		}
-	}
+		JEP_NEXT('=', T_GOREQUAL, 2);
+		return T_GREATER;
 
-	return -1;
+	case '&':
+		JEP_NEXT('=', T_ANDASSIGN, 2);
+		JEP_NEXT('&', T_LOGAND, 2);
+		return T_BITAND;
+
+	case '|':
+		JEP_NEXT('=', T_ORASSIGN, 2);
+		JEP_NEXT('|', T_LOGOR, 2);
+		return T_BITOR;
+
+	case '^':
+		JEP_NEXT('=', T_XORASSIGN, 2);
+		return T_BITXOR;
+
+	case ':':
+		JEP_NEXT(':', T_DOUBLECOLON, 2);
+		return T_COLON;
+
+	case ';':
+		return T_SEMICOLON;
+
+	case ',':
+		return T_COMMA;
+
+	case '.':
+		return T_PERIOD;
+
+	case '(':
+		return T_LPAREN;
+
+	case ')':
+		return T_RPAREN;
+
+	case '[':
+		return T_LSQUARE;
+
+	case ']':
+		return T_RSQUARE;
+
+	case '{':
+		return T_LBRACE;
+
+	case '}':
+		return T_RBRACE;
+
+	default:
+		*len = 0;
+		return 0;
+	}
 }
 
 /**
@@ -201,40 +255,23 @@ static int jep_is_ident(char c)
 }
 
 /**
- * gives a token a token code. Only symbols and keywords get token codes
+ * gives a keyword token its token code and type.
+ * new is an operator, and local and const are modifiers.
  */
-static void jep_classify_token(jep_token *t)
+static void jep_classify_keyword(jep_token *t, int code)
 {
-	if (t->type == T_SYMBOL)
+	t->type = T_KEYWORD;
+	t->token_code = code;
+
+	if (code == T_NEW)
 	{
-		if (t->val->size == 1)
-		{
-			t->token_code = jep_is_symbol(t->val->buffer) + 1;
-		}
-		else if (t->val->size == 2)
-		{
-			t->token_code = jep_is_symbol2(t->val->buffer) + 23;
-		}
-		else if (t->val->size == 3)
-		{
-			t->token_code = jep_is_symbol3(t->val->buffer) + 42;
-		}
+		/* detect new*/
+		t->type = T_SYMBOL;
 	}
-	else if (t->type == T_KEYWORD)
+	else if (code == T_LOCAL || code == T_CONST)
 	{
-		int code = jep_is_keyword(t->val->buffer);
-		t->token_code = code + 44;
-
-		if (code == 11)
-		{
-			/* detect new*/
-			t->type = T_SYMBOL;
-		}
-		else if (code == 9 || code == 10)
-		{
-			/* detect modifiers */
-			t->type = T_MODIFIER;
-		}
+		/* detect modifiers */
+		t->type = T_MODIFIER;
 	}
 }
 
@@ -341,6 +378,7 @@ jep_token_stream *jep_create_token_stream()
 	ts->dir_size = 0;
 	ts->dir_cap = 50;
 	ts->dir = malloc(50 * sizeof(jep_token));
+	ts->names = jep_create_table();
 	return ts;
 }
 
@@ -352,12 +390,25 @@ void jep_destroy_token_stream(jep_token_stream *ts)
 	int i;
 	for (i = 0; i < ts->size; i++)
 	{
-		jep_destroy_string_builder(ts->tok[i].val);
+		/* interned text is shared, so it's destroyed separately */
+		jep_string_builder *val = ts->tok[i].val;
+		if (jep_table_get_slice(ts->names, val->buffer, val->size) != val)
+		{
+			jep_destroy_string_builder(val);
+		}
 	}
 	for (i = 0; i < ts->dir_size; i++)
 	{
 		jep_destroy_string_builder(ts->dir[i].val);
 	}
+	for (i = 0; i < ts->names->cap; i++)
+	{
+		if (ts->names->entries[i].val != NULL)
+		{
+			jep_destroy_string_builder(ts->names->entries[i].val);
+		}
+	}
+	jep_destroy_table(ts->names);
 	free(ts->tok);
 	free(ts->dir);
 	free(ts);
@@ -453,6 +504,50 @@ int jep_has_directive(jep_token_stream *ts, const char *dir)
 	return 0;
 }
 
+/**
+ * adds the canonical copy of some text to the interned names
+ */
+static jep_string_builder *jep_add_name(jep_token_stream *ts,
+	const char *s, int len)
+{
+	jep_string_builder *sb = malloc(sizeof(jep_string_builder));
+
+	sb->size = len;
+	sb->cap = len + 1;
+	sb->buffer = malloc(sb->cap);
+	memcpy(sb->buffer, s, len);
+	sb->buffer[len] = '\0';
+	jep_table_put_slice(ts->names, sb->buffer, len, sb);
+
+	return sb;
+}
+
+/**
+ * gets the canonical copy of some characters of the source.
+ * the length is part of the key, so text containing '\0' is
+ * not confused with its prefix.
+ */
+static jep_string_builder *jep_intern_slice(jep_token_stream *ts,
+	const char *s, int len)
+{
+	jep_string_builder *sb = jep_table_get_slice(ts->names, s, len);
+
+	if (sb == NULL)
+	{
+		sb = jep_add_name(ts, s, len);
+	}
+
+	return sb;
+}
+
+/**
+ * gets the canonical copy of an identifier or string
+ */
+char *jep_intern(jep_token_stream *ts, const char *s)
+{
+	return jep_intern_slice(ts, s, (int)strlen(s))->buffer;
+}
+
 /**
  * tokenizes the contents of a text file
  */
@@ -465,10 +560,12 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 
 	FILE *in_file;			/* the input file                        */
 	jep_string_builder *sb; /* puts the character data into a string */
+	jep_string_builder *text; /* the text of a string or character  */
 	char *s;				/* the string of character data          */
 	int row;				/* the row of each token in the file     */
 	int col;				/* the column of each token in the file  */
 	int i;					/* loop index                            */
+	int len;				/* number of characters in a symbol      */
 
 	in_file = fopen(file_name, "r");
 	row = 1;
@@ -486,6 +583,7 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 	}
 
 	sb = jep_create_string_builder();
+	text = jep_create_string_builder();
 	jep_scan_file(in_file, sb);
 	s = sb->buffer;
 	i = 0;
@@ -548,6 +646,9 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 					// stop tokenizing the file if the directive
 					// already exists
 					jep_destroy_string_builder(dir);
+					jep_destroy_string_builder(text);
+					jep_destroy_string_builder(sb);
+					fclose(in_file);
 					return;
 				}
 			}
@@ -564,30 +665,33 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 		/* detect identifiers */
 		if (jep_is_ident_start(s[i]))
 		{
-			jep_string_builder *val = jep_create_string_builder();
 			jep_token ident =
 			{
-				val, T_IDENTIFIER, 0, row, col, 0, 0, file_name };
+				NULL, T_IDENTIFIER, 0, row, col, 0, 0, file_name };
+			int start = i;
+			int code;
 			do
 			{
-				jep_append_char(ident.val, s[i++]);
+				i++;
 				col++;
 			} while (jep_is_ident(s[i]));
-			if (jep_is_keyword(ident.val->buffer) >= 0)
+			ident.val = jep_intern_slice(ts, s + start, i - start);
+			code = jep_keyword(s + start, i - start);
+			if (code)
 			{
-				ident.type = T_KEYWORD;
+				jep_classify_keyword(&ident, code);
 			}
-			jep_classify_token(&ident);
 			jep_append_token(ts, ident);
 		}
 
 		/* detect characters */
 		if (s[i] == '\'')
 		{
-			jep_string_builder *val = jep_create_string_builder();
 			jep_token c =
 			{
-				val, T_CHARACTER, 0, row, col, 0, 0, file_name };
+				text, T_CHARACTER, 0, row, col, 0, 0, file_name };
+			text->size = 0;
+			text->buffer[0] = '\0';
 			i++;
 			col++;
 			do
@@ -614,16 +718,18 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 				i++;
 				col++;
 			} while (s[i] != '\'' && i < sb->size);
+			c.val = jep_intern_slice(ts, text->buffer, text->size);
 			jep_append_token(ts, c);
 		}
 
 		/* detect strings */
 		if (s[i] == '"')
 		{
-			jep_string_builder *val = jep_create_string_builder();
 			jep_token str =
 			{
-				val, T_STRING, 0, row, col, 0, 0, file_name };
+				text, T_STRING, 0, row, col, 0, 0, file_name };
+			text->size = 0;
+			text->buffer[0] = '\0';
 			i++;
 			col++;
 			while (s[i] != '"' && i < sb->size)
@@ -650,44 +756,21 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 				i++;
 				col++;
 			}
+			str.val = jep_intern_slice(ts, text->buffer, text->size);
 			jep_append_token(ts, str);
 		}
 
 		/* detect symbols */
-		if (jep_is_symbol_char(s[i]))
+		if (jep_symbol(s + i, &len))
 		{
-			jep_string_builder *val = jep_create_string_builder();
 			jep_token sym =
 			{
-				val, T_SYMBOL, 0, row, col, 0, 0, file_name };
-			char symbol[] = { s[i], '\0', '\0', '\0' };
-			if (i < sb->size - 1)
-			{
-				symbol[1] = s[i + 1];
-				symbol[2] = s[i + 2];
-			}
-
-			if (jep_is_symbol3(symbol) >= 0)
-			{
-				/* handle 3 character symbols */
-				jep_append_string(sym.val, symbol);
-				i += 2;
-				col += 2;
-			}
-			else if (symbol[2] = '\0', jep_is_symbol2(symbol) >= 0)
-			{
-				/* handle 2 character symbols */
-				jep_append_string(sym.val, symbol);
-				i++;
-				col++;
-			}
-			else if (symbol[1] = '\0', jep_is_symbol(symbol) >= 0)
-			{
-				/* handle 1 character symbols */
-				jep_append_string(sym.val, symbol);
-			}
+				NULL, T_SYMBOL, 0, row, col, 0, 0, file_name };
+			sym.token_code = jep_symbol(s + i, &len);
+			sym.val = jep_intern_slice(ts, s + i, len);
+			i += len - 1;
+			col += len - 1;
 
-			jep_classify_token(&sym);
 			jep_append_token(ts, sym);
 
 			if (sym.token_code == T_SEMICOLON && ts->size > 2 && ts->tok[ts->size - 3].token_code == T_IMPORT)
@@ -716,10 +799,10 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 		/* detect numbers */
 		if (isdigit(s[i]))
 		{
-			jep_string_builder *val = jep_create_string_builder();
 			jep_token num =
 			{
-				val, T_NUMBER, 0, row, col, 0, 0, file_name };
+				NULL, T_NUMBER, 0, row, col, 0, 0, file_name };
+			int start = i;
 			int dec = 0;
 			do
 			{
@@ -729,17 +812,16 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 
 				if (dec < 2)
 				{
-					jep_append_char(num.val, s[i]);
 					i++;
 				}
 				col++;
 			} while ((isdigit(s[i]) || s[i] == '.') && dec < 2);
 			if (s[i] == 'b')
 			{
-				jep_append_char(num.val, s[i]);
 				i++;
 				col++;
 			}
+			num.val = jep_intern_slice(ts, s + start, i - start);
 			jep_append_token(ts, num);
 			i--;
 			col--;
@@ -761,12 +843,13 @@ void jep_tokenize_file(jep_token_stream *ts, const char *file_name)
 	/* append an END token */
 	jep_token end_token =
 	{
-		jep_create_string_builder(), T_END, T_EOF, row, col, 0, 0, file_name };
-	jep_append_string(end_token.val, "EOF");
+		NULL, T_END, T_EOF, row, col, 0, 0, file_name };
+	end_token.val = jep_intern_slice(ts, "EOF", 3);
 	jep_append_token(ts, end_token);
 
 	/* free memory */
 	fclose(in_file);
+	jep_destroy_string_builder(text);
 	jep_destroy_string_builder(sb);
 }
 
@@ -0,0 +1,873 @@
+/*
+	Functions for executing bytecode
+	Copyright (C) 2016 John Powell
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "swap/vm.h"
+#include "swap/resolver.h"
+
+/* stack space that doesn't need to be allocated on the heap */
+#define JEP_VM_STACK 16
+#define JEP_VM_SCOPES 8
+
+/*
+ * GCC and Clang can jump directly from one instruction to the next
+ * through a table of label addresses. Other compilers use a switch.
+ */
+#if defined(__GNUC__)
+#	define JEP_THREADED
+#endif
+
+#ifdef JEP_THREADED
+#	define VM_CASE(op) L_##op:
+#	define VM_NEXT() goto *labels[ip->op]
+#else
+#	define VM_CASE(op) case op:
+#	define VM_NEXT() goto dispatch
+#endif
+
+/* binary operations, which pass on an exception thrown by an operand */
+#define VM_OPERANDS(fn)\
+	{\
+		jep_obj *r = *--sp;\
+		if (sp[-1] != NULL && sp[-1]->ret & JEP_EXCEPTION)\
+		{\
+			jep_destroy_object(r);\
+		}\
+		else if (r != NULL && r->ret & JEP_EXCEPTION)\
+		{\
+			jep_destroy_object(sp[-1]);\
+			sp[-1] = r;\
+		}\
+		else\
+		{\
+			sp[-1] = fn(sp[-1], r);\
+		}\
+		ip++;\
+		VM_NEXT();\
+	}
+
+#ifdef JEP_THREADED
+#	define VM_BINARY(op, fn) L_##op: VM_OPERANDS(fn)
+#else
+#	define VM_BINARY(op, fn) case op: VM_OPERANDS(fn)
+#endif
+
+/*
+ * a call that the VM makes without recursing. the frame holds the
+ * state of its caller, and the operand stack and scopes of the
+ * called chunk follow it in the same block.
+ */
+typedef struct VMFrame
+{
+	jep_frame frame;        /* slots of the call                    */
+	jep_obj *func;          /* function being called                */
+	jep_obj *args;          /* arguments, which are the call's scope */
+	jep_chunk *chunk;       /* chunk of the caller                  */
+	jep_instr *ip;          /* call instruction of the caller       */
+	jep_obj **stack;        /* operand stack of the caller          */
+	jep_obj **sp;           /* top of the caller's operand stack    */
+	jep_obj **scopes;       /* scopes added by the caller           */
+	int depth;              /* number of scopes added by the caller */
+	size_t size;            /* bytes allocated for the frame        */
+	struct VMFrame *caller; /* frame of the caller                  */
+}jep_vm_frame;
+
+/* removes the innermost scope of a chunk */
+#define VM_POP_SCOPE()\
+	{\
+		jep_remove_scope(list);\
+		jep_destroy_object(scopes[--depth]);\
+	}
+
+/* executes a chunk of bytecode */
+jep_obj *jep_execute(jep_chunk *chunk, jep_obj *list)
+{
+#ifdef JEP_THREADED
+	static void *labels[OP_COUNT] =
+	{
+		[OP_END] = &&L_OP_END,
+		[OP_NONE] = &&L_OP_NONE,
+		[OP_NULL] = &&L_OP_NULL,
+		[OP_NUMBER] = &&L_OP_NUMBER,
+		[OP_CHARACTER] = &&L_OP_CHARACTER,
+		[OP_STRING] = &&L_OP_STRING,
+		[OP_LOAD] = &&L_OP_LOAD,
+		[OP_DROP] = &&L_OP_DROP,
+		[OP_ADD] = &&L_OP_ADD,
+		[OP_SUB] = &&L_OP_SUB,
+		[OP_MUL] = &&L_OP_MUL,
+		[OP_DIV] = &&L_OP_DIV,
+		[OP_MOD] = &&L_OP_MOD,
+		[OP_LESS] = &&L_OP_LESS,
+		[OP_GREATER] = &&L_OP_GREATER,
+		[OP_LOREQUAL] = &&L_OP_LOREQUAL,
+		[OP_GOREQUAL] = &&L_OP_GOREQUAL,
+		[OP_EQUIV] = &&L_OP_EQUIV,
+		[OP_NOTEQ] = &&L_OP_NOTEQ,
+		[OP_BITAND] = &&L_OP_BITAND,
+		[OP_BITOR] = &&L_OP_BITOR,
+		[OP_BITXOR] = &&L_OP_BITXOR,
+		[OP_LSHIFT] = &&L_OP_LSHIFT,
+		[OP_RSHIFT] = &&L_OP_RSHIFT,
+		[OP_NEG] = &&L_OP_NEG,
+		[OP_NOT] = &&L_OP_NOT,
+		[OP_AND_LEFT] = &&L_OP_AND_LEFT,
+		[OP_AND] = &&L_OP_AND,
+		[OP_OR_LEFT] = &&L_OP_OR_LEFT,
+		[OP_OR] = &&L_OP_OR,
+		[OP_ASSIGN] = &&L_OP_ASSIGN,
+		[OP_INC] = &&L_OP_INC,
+		[OP_DEC] = &&L_OP_DEC,
+		[OP_FUNC] = &&L_OP_FUNC,
+		[OP_CALL] = &&L_OP_CALL,
+		[OP_ARRAY] = &&L_OP_ARRAY,
+		[OP_SUBSCRIPT] = &&L_OP_SUBSCRIPT,
+		[OP_RETURN] = &&L_OP_RETURN,
+		[OP_THROW] = &&L_OP_THROW,
+		[OP_EVAL] = &&L_OP_EVAL,
+		[OP_JUMP] = &&L_OP_JUMP,
+		[OP_BRANCH] = &&L_OP_BRANCH,
+		[OP_LOOP] = &&L_OP_LOOP,
+		[OP_NEXT] = &&L_OP_NEXT,
+		[OP_PUSH_SCOPE] = &&L_OP_PUSH_SCOPE,
+		[OP_POP_SCOPE] = &&L_OP_POP_SCOPE,
+		[OP_POP_BLOCK] = &&L_OP_POP_BLOCK,
+		[OP_POP_LOOP] = &&L_OP_POP_LOOP,
+		[OP_POP_TOP] = &&L_OP_POP_TOP,
+		[OP_CATCH] = &&L_OP_CATCH,
+		[OP_CLEAR] = &&L_OP_CLEAR,
+		[OP_ADD_ASSIGN] = &&L_OP_ADD_ASSIGN,
+		[OP_COUNT_NEXT] = &&L_OP_COUNT_NEXT,
+		[OP_TAIL_CALL] = &&L_OP_TAIL_CALL,
+		[OP_QUICK] = &&L_OP_QUICK,
+		[OP_STORE] = &&L_OP_STORE,
+		[OP_MEMBER] = &&L_OP_MEMBER,
+		[OP_SWITCH] = &&L_OP_SWITCH
+	};
+#endif
+
+	jep_obj *stack_buf[JEP_VM_STACK];  /* operand stack             */
+	jep_obj *scope_buf[JEP_VM_SCOPES]; /* scopes added by the chunk */
+	jep_obj **stack = stack_buf;
+	jep_obj **scopes = scope_buf;
+	jep_obj **sp;
+	jep_instr *ip = chunk->code;
+	jep_obj *v = NULL; /* the value that ends a statement */
+	int depth = 0;     /* number of scopes added          */
+	jep_vm_frame *fp = NULL; /* call being run by this loop */
+	jep_env *env = (jep_env *)(list->val);
+
+	if (chunk->stack > JEP_VM_STACK)
+	{
+		stack = malloc(sizeof(jep_obj *) * chunk->stack);
+	}
+
+	if (chunk->scopes > JEP_VM_SCOPES)
+	{
+		scopes = malloc(sizeof(jep_obj *) * chunk->scopes);
+	}
+
+	sp = stack;
+
+#ifdef JEP_THREADED
+	VM_NEXT();
+#else
+dispatch:
+	switch (ip->op)
+	{
+#endif
+
+	VM_CASE(OP_END)
+	{
+		v = sp > stack ? *--sp : NULL;
+		goto done;
+	}
+
+	VM_CASE(OP_NONE)
+	{
+		*sp++ = NULL;
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_NULL)
+	{
+		jep_obj *n = jep_create_object();
+		n->type = JEP_NULL;
+		*sp++ = n;
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_NUMBER)
+	{
+		*sp++ = jep_literal(ip->node);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_CHARACTER)
+	{
+		*sp++ = jep_literal(ip->node);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_STRING)
+	{
+		*sp++ = jep_literal(ip->node);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_LOAD)
+	{
+		*sp++ = jep_identifier(ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_DROP)
+	{
+		if (*--sp != NULL)
+		{
+			jep_destroy_object(*sp);
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_BINARY(OP_ADD, jep_add_objects)
+	VM_BINARY(OP_SUB, jep_sub_objects)
+	VM_BINARY(OP_MUL, jep_mul_objects)
+	VM_BINARY(OP_DIV, jep_div_objects)
+	VM_BINARY(OP_MOD, jep_modulus_objects)
+	VM_BINARY(OP_LESS, jep_less_objects)
+	VM_BINARY(OP_GREATER, jep_greater_objects)
+	VM_BINARY(OP_LOREQUAL, jep_lorequal_objects)
+	VM_BINARY(OP_GOREQUAL, jep_gorequal_objects)
+	VM_BINARY(OP_EQUIV, jep_equiv_objects)
+	VM_BINARY(OP_NOTEQ, jep_noteq_objects)
+	VM_BINARY(OP_BITAND, jep_bitand_objects)
+	VM_BINARY(OP_BITOR, jep_bitor_objects)
+	VM_BINARY(OP_BITXOR, jep_bitxor_objects)
+	VM_BINARY(OP_LSHIFT, jep_lshift_objects)
+	VM_BINARY(OP_RSHIFT, jep_rshift_objects)
+	VM_BINARY(OP_AND, jep_and_objects)
+	VM_BINARY(OP_OR, jep_or_objects)
+
+	VM_CASE(OP_QUICK)
+	{
+		*sp++ = jep_quick_int(ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_SUBSCRIPT)
+	{
+		jep_obj *array = *--sp;
+		if (ip->node->target)
+		{
+			jep_unshare(array);
+		}
+		sp[-1] = jep_subscript_objects(sp[-1], array);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_MEMBER)
+	{
+		sp[-1] = jep_member_object(sp[-1], ip->node);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_NEG)
+	{
+		sp[-1] = jep_neg_object(sp[-1]);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_NOT)
+	{
+		sp[-1] = jep_not_object(sp[-1]);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_AND_LEFT)
+	{
+		jep_obj *result = jep_and_left(sp[-1]);
+		if (result != NULL)
+		{
+			sp[-1] = result;
+			ip = chunk->code + ip->a;
+		}
+		else
+		{
+			ip++;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_OR_LEFT)
+	{
+		jep_obj *result = jep_or_left(sp[-1]);
+		if (result != NULL)
+		{
+			sp[-1] = result;
+			ip = chunk->code + ip->a;
+		}
+		else
+		{
+			ip++;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_ASSIGN)
+	{
+		jep_obj *r = *--sp;
+		sp[-1] = jep_assign_objects(sp[-1], r, ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_STORE)
+	{
+		sp[-1] = jep_assign_objects(NULL, sp[-1], ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_ADD_ASSIGN)
+	{
+		jep_obj *r = *--sp;
+		sp[-1] = jep_add_assign_objects(sp[-1], r, ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_INC)
+	{
+		sp[-1] = jep_inc_object(sp[-1], ip->a);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_DEC)
+	{
+		sp[-1] = jep_dec_object(sp[-1], ip->a);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_FUNC)
+	{
+		/* the function is not a copy, so it is never destroyed */
+		*sp++ = jep_lookup(ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_TAIL_CALL)
+	VM_CASE(OP_CALL)
+	{
+		jep_obj **args = sp - ip->a;
+		jep_obj *func = args[-1];
+		jep_obj *arg_list = NULL;
+		jep_ast_node *body = NULL;
+		int i;
+
+		if (ip->b)
+		{
+			/* the evaluated arguments are moved into the argument list */
+			arg_list = jep_create_object();
+			arg_list->type = JEP_LIST;
+			for (i = 0; i < ip->a; i++)
+			{
+				if (args[i] != NULL)
+				{
+					jep_add_object(arg_list, args[i]);
+				}
+				else if (ip->b == 1)
+				{
+					printf("could not evaluate argument\n");
+				}
+			}
+		}
+
+		sp = args - 1;
+
+		if (func != NULL && func->size == 2)
+		{
+			body = (jep_ast_node *)(func->head->next->val);
+		}
+
+		/*
+		 * a compiled function is run by this loop in a frame on the
+		 * heap, unless it is the tail call of the function itself
+		 */
+		if (body != NULL && body->code != NULL && env != NULL
+			&& !(ip->op == OP_TAIL_CALL && env->frame != NULL
+				&& env->frame->body == body->leaves)
+			&& jep_bind_arguments(func, arg_list))
+		{
+			jep_vm_frame *callee;
+			size_t size;
+
+			if (env->depth >= env->max_depth)
+			{
+				jep_destroy_object(arg_list);
+				*sp++ = jep_exception("maximum call depth exceeded");
+				ip++;
+				VM_NEXT();
+			}
+
+			if (arg_list == NULL)
+			{
+				arg_list = jep_create_object();
+				arg_list->type = JEP_LIST;
+			}
+
+			size = sizeof(jep_vm_frame) + sizeof(jep_obj *)
+				* (body->code->stack + body->code->scopes);
+			callee = jep_pool_alloc(size);
+			callee->func = func;
+			callee->args = arg_list;
+			callee->chunk = chunk;
+			callee->ip = ip;
+			callee->stack = stack;
+			callee->sp = sp;
+			callee->scopes = scopes;
+			callee->depth = depth;
+			callee->size = size;
+			callee->caller = fp;
+
+			jep_enter_frame(&(callee->frame), body, arg_list, list);
+			env->depth++;
+
+			fp = callee;
+			chunk = body->code;
+			ip = chunk->code;
+			stack = (jep_obj **)(callee + 1);
+			scopes = stack + chunk->stack;
+			sp = stack;
+			depth = 0;
+			VM_NEXT();
+		}
+
+		if (func == NULL)
+		{
+			printf("couldn't find a function with the specified identifer\n");
+			jep_destroy_object(arg_list);
+			*sp++ = NULL;
+		}
+		else if (ip->op == OP_TAIL_CALL)
+		{
+			*sp++ = jep_tail_call(func, arg_list, list);
+		}
+		else
+		{
+			*sp++ = jep_call(func, arg_list, list);
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_ARRAY)
+	{
+		sp[-1] = jep_sized_array(sp[-1]);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_RETURN)
+	{
+		if (ip->a)
+		{
+			if (sp[-1] != NULL)
+			{
+				sp[-1]->ret |= JEP_RETURN;
+			}
+		}
+		else
+		{
+			jep_obj *o = jep_create_object();
+			o->type = JEP_ARGUMENT;
+			o->ret = JEP_RETURN;
+			*sp++ = o;
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_THROW)
+	{
+		if (sp[-1] != NULL)
+		{
+			sp[-1]->ret = JEP_RETURN | JEP_EXCEPTION;
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_EVAL)
+	{
+		*sp++ = jep_evaluate(ip->node, list);
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_JUMP)
+	{
+		ip = chunk->code + ip->a;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_BRANCH)
+	{
+		jep_obj *c = *--sp;
+		if (c != NULL && c->type == JEP_INT)
+		{
+			int val = *((int *)(c->val));
+			jep_destroy_object(c);
+			ip = val ? ip + 1 : chunk->code + ip->a;
+		}
+		else
+		{
+			if (c != NULL)
+			{
+				jep_destroy_object(c);
+			}
+			ip = chunk->code + ip->b;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_LOOP)
+	{
+		jep_obj *c = *--sp;
+		int val = 0;
+		if (c != NULL && c->type == JEP_INT)
+		{
+			if (c->val != NULL)
+			{
+				val = *((int *)(c->val));
+			}
+		}
+		else
+		{
+			printf("invalid loop condition expression\n");
+		}
+		if (c != NULL)
+		{
+			jep_destroy_object(c);
+		}
+		ip = val ? ip + 1 : chunk->code + ip->a;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_NEXT)
+	{
+		/* a condition without a value doesn't end the loop */
+		jep_obj *c = *--sp;
+		int val = 1;
+		if (c != NULL)
+		{
+			if (c->val != NULL)
+			{
+				val = *((int *)(c->val));
+			}
+			jep_destroy_object(c);
+		}
+
+		if (val)
+		{
+			/* clear the scope at the end of each iteration */
+			if (ip->b)
+			{
+				jep_clear_scope(scopes[depth - 1]);
+			}
+			ip = chunk->code + ip->a;
+		}
+		else
+		{
+			/* destroy the scope after the last iteration */
+			if (ip->b)
+			{
+				VM_POP_SCOPE();
+			}
+			ip++;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_COUNT_NEXT)
+	{
+		if (jep_count(ip->node, list))
+		{
+			if (ip->b)
+			{
+				jep_clear_scope(scopes[depth - 1]);
+			}
+			ip = chunk->code + ip->a;
+		}
+		else
+		{
+			if (ip->b)
+			{
+				VM_POP_SCOPE();
+			}
+			ip++;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_SWITCH)
+	{
+		jep_obj *check = *--sp;
+		jep_ast_node *block;
+		int i;
+
+		if (check == NULL || check->ret & JEP_EXCEPTION)
+		{
+			/* skip past the absent value of a switch without a match */
+			*sp++ = check;
+			ip = chunk->code + ip->a + 1;
+			VM_NEXT();
+		}
+
+		block = jep_find_case(ip->node->cases, check);
+		jep_destroy_object(check);
+
+		for (i = 1; i <= ip->b; i++)
+		{
+			if (ip[i].node == block)
+			{
+				ip = chunk->code + ip[i].a;
+				VM_NEXT();
+			}
+		}
+		ip = chunk->code + ip->a;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_PUSH_SCOPE)
+	{
+		jep_obj *scope = jep_create_object();
+		scope->type = JEP_LIST;
+		jep_add_object(list, scope);
+		scopes[depth++] = scope;
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_POP_SCOPE)
+	{
+		VM_POP_SCOPE();
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_POP_BLOCK)
+	{
+		v = *--sp;
+		if (v != NULL)
+		{
+			if (v->ret && (v->ret & JEP_EXCEPTION || !(v->ret & JEP_RETURNED)))
+			{
+				goto propagate;
+			}
+			jep_destroy_object(v);
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_POP_LOOP)
+	{
+		v = *--sp;
+		if (v != NULL)
+		{
+			if (v->ret)
+			{
+				goto propagate;
+			}
+			jep_destroy_object(v);
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_POP_TOP)
+	{
+		v = *--sp;
+		if (v != NULL)
+		{
+			if (v->ret & JEP_EXCEPTION)
+			{
+				goto done;
+			}
+			jep_destroy_object(v);
+		}
+		v = NULL;
+		ip++;
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_CATCH)
+	{
+		v = *--sp;
+		if (v != NULL && v->ret & JEP_EXCEPTION)
+		{
+			jep_obj *exception = jep_create_object();
+			jep_obj *scope = jep_create_object();
+
+			exception->ident = ip->node->token.val->buffer;
+			jep_move_object(exception, v);
+			exception->ret = 0; /* the caught value is no longer thrown */
+			jep_destroy_object(v);
+			v = NULL;
+
+			/* create the scope for the catch block */
+			scope->type = JEP_LIST;
+			jep_add_object(list, scope);
+			scopes[depth++] = scope;
+
+			/* add the exception to the scope */
+			jep_add_object(list, exception);
+
+			ip++;
+		}
+		else
+		{
+			if (v != NULL && !v->ret)
+			{
+				jep_destroy_object(v);
+				v = NULL;
+			}
+			*sp++ = v;
+			ip = chunk->code + ip->a;
+		}
+		VM_NEXT();
+	}
+
+	VM_CASE(OP_CLEAR)
+	{
+		if (sp[-1] != NULL && !sp[-1]->ret)
+		{
+			jep_destroy_object(sp[-1]);
+			sp[-1] = NULL;
+		}
+		ip++;
+		VM_NEXT();
+	}
+
+#ifndef JEP_THREADED
+	default:
+		printf("invalid instruction: %d\n", ip->op);
+		v = NULL;
+		goto done;
+	}
+#endif
+
+propagate:
+	/*
+	 * a returned value or an exception leaves the enclosing
+	 * statement, taking the scopes inside of it along
+	 */
+	while (depth > ip->b)
+	{
+		VM_POP_SCOPE();
+	}
+
+	/* values of the statement that were still being evaluated */
+	while (sp > stack)
+	{
+		jep_destroy_object(*--sp);
+	}
+	*sp++ = v;
+	ip = chunk->code + ip->a;
+	VM_NEXT();
+
+done:
+	while (depth > 0)
+	{
+		VM_POP_SCOPE();
+	}
+
+	if (fp != NULL)
+	{
+		jep_vm_frame *callee = fp;
+
+		jep_leave_frame(&(callee->frame), list);
+		jep_destroy_object(callee->args);
+
+		/* the function returned a call to itself */
+		if (v != NULL && v->ret & JEP_TAIL_CALL)
+		{
+			v->ret = 0;
+			callee->args = v;
+			v = NULL;
+			if (jep_bind_arguments(callee->func, callee->args))
+			{
+				jep_enter_frame(&(callee->frame),
+					(jep_ast_node *)(callee->func->head->next->val),
+					callee->args, list);
+				sp = stack;
+				ip = chunk->code;
+				VM_NEXT();
+			}
+			printf("woops, apparently there weren't the right amount of arguments!\n");
+			jep_destroy_object(callee->args);
+		}
+
+		env->depth--;
+
+		if (v != NULL && v->ret & JEP_RETURN)
+		{
+			v->ret |= JEP_RETURNED;
+		}
+
+		/* continue with the caller after its call instruction */
+		chunk = callee->chunk;
+		ip = callee->ip + 1;
+		stack = callee->stack;
+		sp = callee->sp;
+		scopes = callee->scopes;
+		depth = callee->depth;
+		fp = callee->caller;
+		jep_pool_free(callee, callee->size);
+
+		*sp++ = v;
+		v = NULL;
+		VM_NEXT();
+	}
+
+	if (stack != stack_buf)
+	{
+		free(stack);
+	}
+
+	if (scopes != scope_buf)
+	{
+		free(scopes);
+	}
+
+	return v;
+}
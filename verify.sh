@@ -10,6 +10,27 @@ cor6=$(<./tests/correct6.txt)
 cor7=$(<./tests/correct7.txt)
 cor8=$(<./tests/correct8.txt)
 cor9=$(<./tests/correct9.txt)
+cor10=$(<./tests/correct10.txt)
+cor11=$(<./tests/correct11.txt)
+cor12=$(<./tests/correct12.txt)
+cor13=$(<./tests/correct13.txt)
+cor14=$(<./tests/correct14.txt)
+cor15=$(<./tests/correct15.txt)
+cor16=$(<./tests/correct16.txt)
+cor17=$(<./tests/correct17.txt)
+cor18=$(<./tests/correct18.txt)
+cor19=$(<./tests/correct19.txt)
+cor20=$(<./tests/correct20.txt)
+cor21=$(<./tests/correct21.txt)
+cor22=$(<./tests/correct22.txt)
+cor23=$(<./tests/correct23.txt)
+cor24=$(<./tests/correct24.txt)
+cor25=$(<./tests/correct25.txt)
+cor26=$(<./tests/correct26.txt)
+cor27=$(<./tests/correct27.txt)
+cor28=$(<./tests/correct28.txt)
+cor29=$(<./tests/correct29.txt)
+cor30=$(<./tests/correct30.txt)
 
 # get the actual results
 res1=$(<./tests/result1.txt)
@@ -21,9 +42,53 @@ res6=$(<./tests/result6.txt)
 res7=$(<./tests/result7.txt)
 res8=$(<./tests/result8.txt)
 res9=$(<./tests/result9.txt)
+res10=$(<./tests/result10.txt)
+res11=$(<./tests/result11.txt)
+res12=$(<./tests/result12.txt)
+res13=$(<./tests/result13.txt)
+res14=$(<./tests/result14.txt)
+res15=$(<./tests/result15.txt)
+res16=$(<./tests/result16.txt)
+res17=$(<./tests/result17.txt)
+res18=$(<./tests/result18.txt)
+res19=$(<./tests/result19.txt)
+res20=$(<./tests/result20.txt)
+res21=$(<./tests/result21.txt)
+res22=$(<./tests/result22.txt)
+res23=$(<./tests/result23.txt)
+res24=$(<./tests/result24.txt)
+res25=$(<./tests/result25.txt)
+res26=$(<./tests/result26.txt)
+res27=$(<./tests/result27.txt)
+res28=$(<./tests/result28.txt)
+res29=$(<./tests/result29.txt)
+res30=$(<./tests/result30.txt)
+
+# get the results of the tree walker
+walk8=$(<./tests/walk8.txt)
+walk9=$(<./tests/walk9.txt)
+walk10=$(<./tests/walk10.txt)
+walk11=$(<./tests/walk11.txt)
+walk12=$(<./tests/walk12.txt)
+walk13=$(<./tests/walk13.txt)
+walk14=$(<./tests/walk14.txt)
+walk15=$(<./tests/walk15.txt)
+walk16=$(<./tests/walk16.txt)
+walk17=$(<./tests/walk17.txt)
+walk19=$(<./tests/walk19.txt)
+walk20=$(<./tests/walk20.txt)
+walk21=$(<./tests/walk21.txt)
+walk22=$(<./tests/walk22.txt)
+walk23=$(<./tests/walk23.txt)
+walk24=$(<./tests/walk24.txt)
+walk25=$(<./tests/walk25.txt)
+walk26=$(<./tests/walk26.txt)
+walk27=$(<./tests/walk27.txt)
+walk28=$(<./tests/walk28.txt)
+walk29=$(<./tests/walk29.txt)
 
 # the total number of test cases
-cases=9
+cases=51
 
 # the number of test cases that passed
 passed=0
@@ -92,6 +157,301 @@ else
 	echo Test 9: fail
 fi
 
+if [ "$res10" == "$cor10" ]; then
+	echo Test 10: pass
+	let "passed++"
+else
+	echo Test 10: fail
+fi
+
+if [ "$res11" == "$cor11" ]; then
+	echo Test 11: pass
+	let "passed++"
+else
+	echo Test 11: fail
+fi
+
+if [ "$res12" == "$cor12" ]; then
+	echo Test 12: pass
+	let "passed++"
+else
+	echo Test 12: fail
+fi
+
+if [ "$res13" == "$cor13" ]; then
+	echo Test 13: pass
+	let "passed++"
+else
+	echo Test 13: fail
+fi
+
+if [ "$res14" == "$cor14" ]; then
+	echo Test 14: pass
+	let "passed++"
+else
+	echo Test 14: fail
+fi
+
+if [ "$res15" == "$cor15" ]; then
+	echo Test 15: pass
+	let "passed++"
+else
+	echo Test 15: fail
+fi
+
+if [ "$res16" == "$cor16" ]; then
+	echo Test 16: pass
+	let "passed++"
+else
+	echo Test 16: fail
+fi
+
+if [ "$res17" == "$cor17" ]; then
+	echo Test 17: pass
+	let "passed++"
+else
+	echo Test 17: fail
+fi
+
+if [ "$res18" == "$cor18" ]; then
+	echo Test 18: pass
+	let "passed++"
+else
+	echo Test 18: fail
+fi
+
+if [ "$res19" == "$cor19" ]; then
+	echo Test 19: pass
+	let "passed++"
+else
+	echo Test 19: fail
+fi
+
+if [ "$res20" == "$cor20" ]; then
+	echo Test 20: pass
+	let "passed++"
+else
+	echo Test 20: fail
+fi
+
+if [ "$res21" == "$cor21" ]; then
+	echo Test 21: pass
+	let "passed++"
+else
+	echo Test 21: fail
+fi
+
+if [ "$res22" == "$cor22" ]; then
+	echo Test 22: pass
+	let "passed++"
+else
+	echo Test 22: fail
+fi
+
+if [ "$res23" == "$cor23" ]; then
+	echo Test 23: pass
+	let "passed++"
+else
+	echo Test 23: fail
+fi
+
+if [ "$res24" == "$cor24" ]; then
+	echo Test 24: pass
+	let "passed++"
+else
+	echo Test 24: fail
+fi
+
+if [ "$res25" == "$cor25" ]; then
+	echo Test 25: pass
+	let "passed++"
+else
+	echo Test 25: fail
+fi
+
+if [ "$res26" == "$cor26" ]; then
+	echo Test 26: pass
+	let "passed++"
+else
+	echo Test 26: fail
+fi
+
+if [ "$res27" == "$cor27" ]; then
+	echo Test 27: pass
+	let "passed++"
+else
+	echo Test 27: fail
+fi
+
+if [ "$res28" == "$cor28" ]; then
+	echo Test 28: pass
+	let "passed++"
+else
+	echo Test 28: fail
+fi
+
+if [ "$res29" == "$cor29" ]; then
+	echo Test 29: pass
+	let "passed++"
+else
+	echo Test 29: fail
+fi
+
+if [ "$res30" == "$cor30" ]; then
+	echo Test 30: pass
+	let "passed++"
+else
+	echo Test 30: fail
+fi
+
+# compare the tree walker with the bytecode interpreter
+if [ "$walk8" == "$cor8" ]; then
+	echo Test 8 -w: pass
+	let "passed++"
+else
+	echo Test 8 -w: fail
+fi
+
+if [ "$walk9" == "$cor9" ]; then
+	echo Test 9 -w: pass
+	let "passed++"
+else
+	echo Test 9 -w: fail
+fi
+
+if [ "$walk10" == "$cor10" ]; then
+	echo Test 10 -w: pass
+	let "passed++"
+else
+	echo Test 10 -w: fail
+fi
+
+if [ "$walk11" == "$cor11" ]; then
+	echo Test 11 -w: pass
+	let "passed++"
+else
+	echo Test 11 -w: fail
+fi
+
+if [ "$walk12" == "$cor12" ]; then
+	echo Test 12 -w: pass
+	let "passed++"
+else
+	echo Test 12 -w: fail
+fi
+
+if [ "$walk13" == "$cor13" ]; then
+	echo Test 13 -w: pass
+	let "passed++"
+else
+	echo Test 13 -w: fail
+fi
+
+if [ "$walk14" == "$cor14" ]; then
+	echo Test 14 -w: pass
+	let "passed++"
+else
+	echo Test 14 -w: fail
+fi
+
+if [ "$walk15" == "$cor15" ]; then
+	echo Test 15 -w: pass
+	let "passed++"
+else
+	echo Test 15 -w: fail
+fi
+
+if [ "$walk16" == "$cor16" ]; then
+	echo Test 16 -w: pass
+	let "passed++"
+else
+	echo Test 16 -w: fail
+fi
+
+if [ "$walk17" == "$cor17" ]; then
+	echo Test 17 -w: pass
+	let "passed++"
+else
+	echo Test 17 -w: fail
+fi
+
+if [ "$walk19" == "$cor19" ]; then
+	echo Test 19 -w: pass
+	let "passed++"
+else
+	echo Test 19 -w: fail
+fi
+
+if [ "$walk20" == "$cor20" ]; then
+	echo Test 20 -w: pass
+	let "passed++"
+else
+	echo Test 20 -w: fail
+fi
+
+if [ "$walk21" == "$cor21" ]; then
+	echo Test 21 -w: pass
+	let "passed++"
+else
+	echo Test 21 -w: fail
+fi
+
+if [ "$walk22" == "$cor22" ]; then
+	echo Test 22 -w: pass
+	let "passed++"
+else
+	echo Test 22 -w: fail
+fi
+
+if [ "$walk23" == "$cor23" ]; then
+	echo Test 23 -w: pass
+	let "passed++"
+else
+	echo Test 23 -w: fail
+fi
+
+if [ "$walk24" == "$cor24" ]; then
+	echo Test 24 -w: pass
+	let "passed++"
+else
+	echo Test 24 -w: fail
+fi
+
+if [ "$walk25" == "$cor25" ]; then
+	echo Test 25 -w: pass
+	let "passed++"
+else
+	echo Test 25 -w: fail
+fi
+
+if [ "$walk26" == "$cor26" ]; then
+	echo Test 26 -w: pass
+	let "passed++"
+else
+	echo Test 26 -w: fail
+fi
+
+if [ "$walk27" == "$cor27" ]; then
+	echo Test 27 -w: pass
+	let "passed++"
+else
+	echo Test 27 -w: fail
+fi
+
+if [ "$walk28" == "$cor28" ]; then
+	echo Test 28 -w: pass
+	let "passed++"
+else
+	echo Test 28 -w: fail
+fi
+
+if [ "$walk29" == "$cor29" ]; then
+	echo Test 29 -w: pass
+	let "passed++"
+else
+	echo Test 29 -w: fail
+fi
+
 echo ============================================
 echo $passed out of $cases test cases succeeded
 echo ============================================